@@ -0,0 +1,222 @@
+#include <vsl/tcp/tcp_listener.h>
+#include <vsl/tcp/tcp_metrics.h>
+#include <vsl/tcp/tcp_metrics_report.h>
+#include <vsl/threading.h>
+
+#include <nanobench.h>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Loopback benchmarks of vsl::tcp. Usage: tcp_benchmark [result.json]
+// The result file holds the nanobench JSON of each group and the ping-pong RTT percentiles,
+// so the runs of different releases can be compared.
+
+using namespace ankerl::nanobench;
+using vsl::tcp::LatencyHistogram;
+using vsl::tcp::TcpClient;
+using vsl::tcp::TcpClientError;
+using vsl::tcp::TcpListener;
+using vsl::tcp::TcpMetrics;
+
+constexpr auto LOOPBACK_IP = "127.0.0.1";
+constexpr auto MESSAGES_PER_BATCH = size_t{1000};
+
+struct Connection
+{
+    TcpClient client;
+    TcpClient server;
+};
+
+auto connect_loopback(TcpListener& listener) -> Connection
+{
+    auto connection = Connection{};
+    connection.client.connect(LOOPBACK_IP, listener.get_port());
+    connection.server = listener.accept_client();
+    return connection;
+}
+
+// Client side is closed first, the server reads until then
+auto run_with_drain(TcpListener& listener, auto&& func) -> void
+{
+    auto connection = connect_loopback(listener);
+    auto drain = vsl::run_async([&] { connection.server.wait_for_disconnect(); });
+
+    func(connection.client);
+
+    connection.client.close();
+    drain.get();
+    connection.server.close();
+}
+
+auto render_json(Bench& bench) -> nlohmann::json
+{
+    auto output = std::stringstream{};
+    bench.render(templates::json(), output);
+    return nlohmann::json::parse(output.str());
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+auto bench_small_writes(TcpListener& listener) -> nlohmann::json
+{
+    auto bench = Bench{};
+    bench.title("Small scalar writes").unit("msg").batch(MESSAGES_PER_BATCH).relative(true);
+
+    run_with_drain(listener,
+                   [&](TcpClient& client)
+                   {
+                       bench.run("write<int64_t> / buffer off",
+                                 [&]
+                                 {
+                                     for (auto i = size_t{0}; i < MESSAGES_PER_BATCH; ++i)
+                                     {
+                                         client.write(static_cast<int64_t>(i));
+                                     }
+                                     client.flush();
+                                 });
+
+                       bench.run("write<int64_t> / buffer on",
+                                 [&]
+                                 {
+                                     client.enable_buffer(true);
+                                     for (auto i = size_t{0}; i < MESSAGES_PER_BATCH; ++i)
+                                     {
+                                         client.write(static_cast<int64_t>(i));
+                                     }
+                                     client.enable_buffer(false);
+                                     client.write_buffer();
+                                     client.flush();
+                                 });
+                   });
+
+    return render_json(bench);
+}
+
+auto bench_vector_writes(TcpListener& listener) -> nlohmann::json
+{
+    auto bench = Bench{};
+    bench.title("write_vector throughput").unit("byte");
+
+    run_with_drain(listener,
+                   [&](TcpClient& client)
+                   {
+                       for (auto payload_size : {size_t{64}, size_t{4} << 10, size_t{64} << 10, size_t{1} << 20})
+                       {
+                           auto data = std::vector<double>(payload_size / sizeof(double), 1.0);
+
+                           bench.batch(payload_size).run(fmt::format("write_vector / {} bytes", payload_size),
+                                                         [&]
+                                                         {
+                                                             client.write_vector(data);
+                                                             client.flush();
+                                                         });
+                       }
+                   });
+
+    return render_json(bench);
+}
+
+// Each round trip is also recorded to the histogram for the percentiles
+auto bench_ping_pong(TcpListener& listener, LatencyHistogram& rtt) -> nlohmann::json
+{
+    auto bench = Bench{};
+    bench.title("Ping-pong").unit("round trip");
+
+    auto connection = connect_loopback(listener);
+    auto echo = vsl::run_async(
+        [&]
+        {
+            try
+            {
+                while (true)
+                {
+                    connection.server.write(connection.server.read<int64_t>());
+                    connection.server.flush();
+                }
+            }
+            catch (const TcpClientError&)
+            {
+            }
+        });
+
+    auto value = int64_t{0};
+    bench.run("write<int64_t> + read<int64_t>",
+              [&]
+              {
+                  auto start = TcpMetrics::Clock::now();
+                  connection.client.write(++value);
+                  connection.client.flush();
+                  doNotOptimizeAway(connection.client.read<int64_t>());
+                  rtt.record(TcpMetrics::Clock::now() - start);
+              });
+
+    connection.client.close();
+    echo.get();
+    connection.server.close();
+
+    return render_json(bench);
+}
+
+auto bench_connection_setup(TcpListener& listener) -> nlohmann::json
+{
+    auto bench = Bench{};
+    bench.title("Connection setup").unit("connection");
+
+    bench.run("connect + accept_client + close",
+              [&]
+              {
+                  auto connection = connect_loopback(listener);
+                  connection.client.close();
+                  connection.server.close();
+              });
+
+    return render_json(bench);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+auto main(int argc, char* argv[]) -> int
+{
+    const auto result_path = std::string{(argc > 1) ? argv[1] : "tcp_benchmark.json"};
+
+    try
+    {
+        auto listener = TcpListener{};
+        listener.start(LOOPBACK_IP, 0);
+
+        auto rtt = LatencyHistogram{};
+
+        auto result = nlohmann::json{};
+        result["small_writes"] = bench_small_writes(listener);
+        result["vector_writes"] = bench_vector_writes(listener);
+        result["ping_pong"] = bench_ping_pong(listener, rtt);
+        result["ping_pong_rtt_ns"] = rtt.snapshot();
+        result["connection_setup"] = bench_connection_setup(listener);
+
+        listener.stop();
+
+        const auto rtt_snapshot = rtt.snapshot();
+        fmt::println("\nPing-pong RTT, us: p50 {:.1f}, p99 {:.1f}, p99.9 {:.1f}",
+                     static_cast<double>(rtt_snapshot.p50_ns) / 1000.0,
+                     static_cast<double>(rtt_snapshot.p99_ns) / 1000.0,
+                     static_cast<double>(rtt_snapshot.p999_ns) / 1000.0);
+
+        auto file = std::ofstream{result_path};
+        file << result.dump(4) << '\n';
+        fmt::println("Results: {}", result_path);
+    }
+    catch (const std::exception& ex)
+    {
+        fmt::println(stderr, "Error: {}", ex.what());
+        return 1;
+    }
+}
@@ -3,7 +3,9 @@
 
 #include <vsl/encodings/all.h>
 #include <vsl/encodings/detail.h>
+#include <vsl/concepts.h>
 #include <vsl/types.h>
+#include <vsl/unicode.h>
 
 #include <uni_algo/ranges_conv.h>
 
@@ -13,6 +15,8 @@
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace vsl
 {
@@ -55,12 +59,38 @@ inline auto append_encoding_map_repl(std::string& out, std::array<unsigned char,
     }
 }
 
+template<encodings::detail::translit Translit>
+inline constexpr auto find_translit_entry(char32_t cp) noexcept -> const encodings::detail::TranslitEntry*
+{
+    const auto index = static_cast<size_t>(cp - Translit::translit_first_codepoint);
+    if (cp < Translit::translit_first_codepoint || index >= Translit::translit_table.size()) return nullptr;
+
+    const auto& entry = Translit::translit_table[index];
+    return (entry.size > 0) ? &entry : nullptr;
+}
+
+template<encodings::detail::translit Translit>
+inline constexpr auto get_letter_case(char32_t cp) noexcept -> encodings::detail::LetterCase
+{
+    using encodings::detail::LetterCase;
+
+    if (cp >= 'A' && cp <= 'Z') return LetterCase::UPPER;
+    if (cp >= 'a' && cp <= 'z') return LetterCase::LOWER;
+
+    const auto* entry = find_translit_entry<Translit>(cp);
+    return entry ? entry->letter_case : LetterCase::NONE;
+}
+
 }  // namespace detail
 
 [[nodiscard]]
 inline constexpr auto is_ascii(std::string_view str) noexcept -> bool
 {
-    return std::ranges::all_of(str, detail::is_ascii_char);
+    if (std::is_constant_evaluated())
+    {
+        return std::ranges::all_of(str, detail::is_ascii_char);
+    }
+    return detail::ascii_prefix_size(str.data(), str.size()) == str.size();
 }
 
 template<encodings::detail::encoding_to Encoding>
@@ -133,6 +163,108 @@ inline auto from_encoding(std::string_view str, const Encoding& encoding) -> std
     return res;
 }
 
+// Unlike to_encoding(), multi-letter replacements of capital letters follow the word case:
+// "Жук" -> "Zhuk", but "ЖУК" -> "ZHUK"
+template<encodings::detail::translit Translit>
+inline auto transliterate(std::string& out, std::string_view str, const Translit&, char repl_char = '?') -> void
+{
+    using encodings::detail::LetterCase;
+
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    auto prev_case = LetterCase::NONE;
+    auto next_it = it;
+    auto next_cp = (it != end) ? detail::decode_utf8(next_it, end) : char32_t{};
+
+    while (it != end)
+    {
+        if (next_cp < detail::FIRST_NON_ASCII_CHAR)
+        {
+            const auto* ascii_end = std::find_if_not(it, end, detail::is_ascii_char);
+            out.append(it, ascii_end);
+            prev_case = detail::get_letter_case<Translit>(static_cast<unsigned char>(*(ascii_end - 1)));
+
+            it = ascii_end;
+            next_it = it;
+            next_cp = (it != end) ? detail::decode_utf8(next_it, end) : char32_t{};
+            continue;
+        }
+
+        const auto cp = next_cp;
+        it = next_it;
+        next_cp = (it != end) ? detail::decode_utf8(next_it, end) : char32_t{};
+
+        const auto* entry = detail::find_translit_entry<Translit>(cp);
+        if (!entry)
+        {
+            out += repl_char;
+            prev_case = LetterCase::NONE;
+            continue;
+        }
+
+        out.append(entry->repl.data(), entry->size);
+
+        if (entry->size > 1 && entry->letter_case == LetterCase::UPPER)
+        {
+            const auto next_case = (it != end) ? detail::get_letter_case<Translit>(next_cp) : LetterCase::NONE;
+            const auto is_all_caps_word = (next_case == LetterCase::UPPER)
+                                          || (next_case == LetterCase::NONE && prev_case == LetterCase::UPPER);
+            if (is_all_caps_word)
+            {
+                for (auto& c : std::ranges::subrange(out.end() - entry->size + 1, out.end()))
+                {
+                    if (c >= 'a' && c <= 'z') c -= ('a' - 'A');
+                }
+            }
+        }
+
+        prev_case = entry->letter_case;
+    }
+}
+
+template<encodings::detail::translit Translit>
+[[nodiscard]]
+inline auto transliterate(std::string_view str, const Translit& translit, char repl_char = '?') -> std::string
+{
+    auto res = std::string{};
+    translit.to_encoding_reserve(res, str);
+
+    transliterate(res, str, translit, repl_char);
+
+    return res;
+}
+
+// Batch version (e.g., for a whole CSV column)
+template<encodings::detail::translit Translit, std::ranges::input_range R>
+    requires vsl::range_of_string_like<R>
+inline auto transliterate(std::vector<std::string>& out, const R& strs, const Translit& translit, char repl_char = '?')
+    -> void
+{
+    if constexpr (std::ranges::sized_range<R>)
+    {
+        out.reserve(out.size() + std::ranges::size(strs));
+    }
+
+    for (const auto& str : strs)
+    {
+        const auto str_view = std::string_view{str};
+        auto& res = out.emplace_back();
+        translit.to_encoding_reserve(res, str_view);
+        transliterate(res, str_view, translit, repl_char);
+    }
+}
+
+template<encodings::detail::translit Translit, std::ranges::input_range R>
+    requires vsl::range_of_string_like<R>
+[[nodiscard]]
+inline auto transliterate(const R& strs, const Translit& translit, char repl_char = '?') -> std::vector<std::string>
+{
+    auto res = std::vector<std::string>{};
+    transliterate(res, strs, translit, repl_char);
+    return res;
+}
+
 }  // namespace vsl
 
 #endif  // VSL_ENCODING_H
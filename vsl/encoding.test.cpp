@@ -3,7 +3,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 using namespace testing;
 
@@ -113,6 +116,74 @@ TEST(EncodingTest, ToTranslit)
     EXPECT_EQ(to("\x7F\x80Щ", encoding), "\x7F?Shh");
 }
 
+template<typename... Args>
+auto translit(Args&&... args)
+{
+    auto res1 = std::string{};
+    res1.reserve(100);
+    vsl::transliterate(res1, std::forward<Args>(args)...);
+
+    const auto res2 = vsl::transliterate(std::forward<Args>(args)...);
+    EXPECT_EQ(res1, res2);
+
+    return res1;
+}
+
+TEST(EncodingTest, Transliterate)
+{
+    const auto& encoding = vsl::encodings::translit_ru;
+
+    EXPECT_EQ(translit("", encoding), "");
+    EXPECT_EQ(translit("  \t\r\n  ", encoding), "  \t\r\n  ");
+
+    EXPECT_EQ(translit(ASCII_SYMBOLS, encoding), ASCII_SYMBOLS);
+    EXPECT_EQ(translit("Тест ascii", encoding), "Test ascii");
+    EXPECT_EQ(translit("ascii Тест", encoding), "ascii Test");
+
+    EXPECT_EQ(translit("Тест 🚧", encoding), "Test ?");
+    EXPECT_EQ(translit("Тест 🚧", encoding, 'x'), "Test x");
+
+    EXPECT_EQ(translit("Щука, Эхо, Съезд, Юра, Ягода", encoding), "Shhuka, E`xo, S``ezd, Yura, Yagoda");
+
+    EXPECT_EQ(translit("Привет\xC2мир", encoding), "Privet?mir");
+    EXPECT_EQ(translit("Привет\xD0", encoding), "Privet?");
+    EXPECT_EQ(translit("\x7F\x80Щ", encoding), "\x7F?Shh");
+    EXPECT_EQ(translit("\xED\xA0\x80Ж", encoding), "???Zh");
+}
+
+TEST(EncodingTest, TransliterateWordCase)
+{
+    const auto& encoding = vsl::encodings::translit_ru;
+
+    EXPECT_EQ(translit("Ж", encoding), "Zh");
+    EXPECT_EQ(translit("Жук", encoding), "Zhuk");
+    EXPECT_EQ(translit("ЖУК", encoding), "ZHUK");
+    EXPECT_EQ(translit("ЁЖ", encoding), "YOZH");
+    EXPECT_EQ(translit("Ёж", encoding), "Yozh");
+    EXPECT_EQ(translit("ПАША", encoding), "PASHA");
+    EXPECT_EQ(translit("ПАШ Щи", encoding), "PASH Shhi");
+    EXPECT_EQ(translit("ЩИ", encoding), "SHHI");
+    EXPECT_EQ(translit("ЭХО", encoding), "E`XO");
+    EXPECT_EQ(translit("ОБЪЁМ", encoding), "OB``YOM");
+    EXPECT_EQ(translit("ЖZ", encoding), "ZHZ");
+    EXPECT_EQ(translit("Z Ж", encoding), "Z Zh");
+    EXPECT_EQ(translit("ZЖ", encoding), "ZZH");
+}
+
+TEST(EncodingTest, TransliterateBatch)
+{
+    const auto& encoding = vsl::encodings::translit_ru;
+
+    const auto names = std::vector<std::string>{"Иван", "ЖАННА", "", "Щукин 🚧"};
+    const auto expected = std::vector<std::string>{"Ivan", "ZHANNA", "", "Shhukin ?"};
+
+    EXPECT_EQ(vsl::transliterate(names, encoding), expected);
+
+    auto res = std::vector<std::string>{"x"};
+    vsl::transliterate(res, std::vector<std::string_view>{"Юля", "ЮЛЯ"}, encoding, '_');
+    EXPECT_THAT(res, ElementsAre("x", "Yulya", "YULYA"));
+}
+
 TEST(EncodingTest, FromCp1251)
 {
     const auto& encoding = vsl::encodings::cp1251;
@@ -9,6 +9,7 @@
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -41,6 +42,56 @@ concept encoding_to = requires(const Encoding& encoding, std::string& s, std::st
     { encoding.to_encoding_reserve(s, sv) } -> std::same_as<void>;
 };
 
+enum class LetterCase : uint8_t
+{
+    NONE,
+    LOWER,
+    UPPER,
+};
+
+inline constexpr size_t TRANSLIT_MAX_REPL_SIZE = 3;
+
+struct TranslitEntry
+{
+    std::array<char, TRANSLIT_MAX_REPL_SIZE> repl{};
+    uint8_t size{0};
+    LetterCase letter_case{LetterCase::NONE};
+};
+
+template<size_t TableSize>
+using TranslitTable = std::array<TranslitEntry, TableSize>;
+
+// Direct lookup table for the code points [first_codepoint, first_codepoint + TableSize)
+template<size_t TableSize, typename MapType>
+consteval auto make_translit_table(const MapType& map, uint32_t first_codepoint) -> TranslitTable<TableSize>
+{
+    constexpr auto repl_size = std::tuple_size_v<typename MapType::value_type::second_type>;
+    static_assert(repl_size <= TRANSLIT_MAX_REPL_SIZE);
+
+    auto table = TranslitTable<TableSize>{};
+    for (const auto& [cp, repl] : map)
+    {
+        if (cp < first_codepoint || cp - first_codepoint >= TableSize) continue;
+
+        auto& entry = table[cp - first_codepoint];
+        while (entry.size < repl_size && repl[entry.size] != '\0')
+        {
+            entry.repl[entry.size] = static_cast<char>(repl[entry.size]);
+            ++entry.size;
+        }
+
+        if (repl[0] >= 'A' && repl[0] <= 'Z') entry.letter_case = LetterCase::UPPER;
+        if (repl[0] >= 'a' && repl[0] <= 'z') entry.letter_case = LetterCase::LOWER;
+    }
+    return table;
+}
+
+template<typename Encoding>
+concept translit = encoding_to<Encoding> && requires {
+    { Encoding::translit_first_codepoint } -> std::convertible_to<uint32_t>;
+    { Encoding::translit_table[0] } -> std::convertible_to<TranslitEntry>;
+};
+
 template<typename Encoding>
 concept encoding_from = requires(const Encoding& encoding, std::string& s, std::string_view sv) {
     Encoding::from_encoding_map;
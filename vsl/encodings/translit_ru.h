@@ -44,6 +44,12 @@ struct Encoding
         out.reserve(str.size() + str.size() / 2);  // +50%
     }
 
+    // --- Transliteration ------------------------------------------------------------------------
+
+    // Cyrillic block up to U+045F
+    static inline constexpr uint32_t translit_first_codepoint = 0x0400;
+    static inline constexpr auto translit_table = make_translit_table<0x60>(to_encoding_map, translit_first_codepoint);
+
     // --------------------------------------------------------------------------------------------
 };
 
@@ -11,13 +11,19 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 // Reference:
 // https://json.nlohmann.me/
@@ -28,6 +34,14 @@ namespace vsl::detail
 template<typename T>
 concept is_basic_json = nlohmann::detail::is_basic_json<T>::value;
 
+template<typename JsonContext>
+[[noreturn]]
+auto throw_unknown_json_key(std::string_view key, const JsonContext* context) -> void
+{
+    const auto msg = fmt::format("Unknown JSON key {:?}", key);
+    throw nlohmann::json::out_of_range::create(403, msg, context);
+}
+
 template<is_basic_json BasicJsonType, std::ranges::input_range R>
 auto check_json_keys(const BasicJsonType& json, const R& allowed_keys) -> void
     requires vsl::range_of_string_like<R>
@@ -37,8 +51,7 @@ auto check_json_keys(const BasicJsonType& json, const R& allowed_keys) -> void
     {
         if (std::ranges::find(allowed_keys, el.key()) == allowed_keys.end())
         {
-            const auto msg = fmt::format("Unknown JSON key {:?}", el.key());
-            throw nlohmann::json::out_of_range::create(403, msg, &json);
+            throw_unknown_json_key(el.key(), &json);
         }
     }
 }
@@ -51,8 +64,7 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     {
         if (!reference.contains(key))
         {
-            const auto msg = fmt::format("Unknown JSON key {:?}", key);
-            throw nlohmann::json::out_of_range::create(403, msg, &input);
+            throw_unknown_json_key(key, &input);
         }
 
         auto& ref_val = reference[key];
@@ -63,11 +75,144 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     }
 }
 
+// Perfect hash of the field names: the seed is searched at compile time so that all the keys get distinct slots,
+// so a lookup is one hash and one compare, whatever the number of fields
+template<size_t N>
+class JsonKeyIndex final
+{
+  public:
+    consteval explicit JsonKeyIndex(const std::array<std::string_view, N>& keys)
+        : keys_{keys}
+    {
+        for (auto i = size_t{0}; i < N; ++i)
+        {
+            if (std::ranges::find(keys.begin(), keys.begin() + i, keys[i]) != keys.begin() + i)
+            {
+                throw std::invalid_argument{"Duplicate JSON key"};
+            }
+        }
+
+        while (!try_seed())
+        {
+            ++seed_;
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto find(std::string_view key) const noexcept -> std::optional<size_t>
+    {
+        const auto slot = slots_[hash(key, seed_) & (TABLE_SIZE - 1)];
+        if (slot == 0 || keys_[slot - 1u] != key) return std::nullopt;
+        return size_t{slot - 1u};
+    }
+
+  private:
+    // 8 slots per key take a few seeds to find even for 64 keys
+    static constexpr auto TABLE_SIZE = std::bit_ceil(std::max(N * 8, size_t{8}));
+
+    static_assert(N < 255, "Slots hold the key index + 1 in a byte");
+
+    // FNV-1a with the seeded basis, the high half is folded into the low bits used for the slot
+    static constexpr auto hash(std::string_view key, uint32_t seed) noexcept -> uint32_t
+    {
+        auto value = uint32_t{2166136261u} ^ (seed * uint32_t{0x9e3779b9u});
+        for (auto ch : key)
+        {
+            value ^= static_cast<unsigned char>(ch);
+            value *= uint32_t{16777619u};
+        }
+        return value ^ (value >> 16);
+    }
+
+    constexpr auto try_seed() -> bool
+    {
+        slots_ = {};
+        for (auto i = size_t{0}; i < N; ++i)
+        {
+            auto& slot = slots_[hash(keys_[i], seed_) & (TABLE_SIZE - 1)];
+            if (slot != 0) return false;
+            slot = static_cast<uint8_t>(i + 1);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> keys_{};
+    std::array<uint8_t, TABLE_SIZE> slots_{};
+    uint32_t seed_{0};
+};
+
+template<is_basic_json BasicJsonType, size_t N>
+auto check_json_keys(const BasicJsonType& json, const JsonKeyIndex<N>& key_index) -> void
+{
+    if (!json.is_object()) return;
+    for (auto&& el : json.items())
+    {
+        if (!key_index.find(el.key()).has_value())
+        {
+            throw_unknown_json_key(el.key(), &json);
+        }
+    }
+}
+
+// Field of a VSL_JSON_STRICT* struct, see vsl_json_strict_fields()
+template<typename Struct, typename Member>
+struct JsonField
+{
+    std::string_view key;
+    Member Struct::*member;
+};
+
+template<typename T>
+concept json_strict_struct = requires {
+    vsl_json_strict_fields(static_cast<const T*>(nullptr));
+    vsl_json_strict_with_default(static_cast<const T*>(nullptr));
+};
+
+template<json_strict_struct T>
+struct JsonStrictStructInfo
+{
+    static constexpr auto fields = vsl_json_strict_fields(static_cast<const T*>(nullptr));
+    static constexpr auto field_count = std::tuple_size_v<std::remove_const_t<decltype(fields)>>;
+    static constexpr auto with_default = vsl_json_strict_with_default(static_cast<const T*>(nullptr));
+    static constexpr auto keys =
+        std::apply([](auto... field) { return std::array<std::string_view, sizeof...(field)>{field.key...}; }, fields);
+    static constexpr auto key_index = JsonKeyIndex<field_count>{keys};
+
+    static_assert(field_count <= 64, "Seen fields are tracked in a 64-bit mask");
+};
+
+template<typename T, typename JsonContext>
+    requires std::is_enum_v<T>
+auto enum_from_json_name(std::string_view name, const JsonContext* context) -> T
+{
+    const auto value = vsl::enum_from_string_icase<T>(name);
+    if (!value.has_value())
+    {
+        const auto msg = fmt::format("Unknown enum value: {}", name);
+        throw nlohmann::json::type_error::create(302, msg, context);
+    }
+    return value.value();
+}
+
 }  // namespace vsl::detail
 
-#define VSL_DETAIL_JSON_KEY_STR(v1) #v1,
+#define VSL_DETAIL_JSON_FIELD(v1) vsl::detail::JsonField{#v1, &vsl_json_type::v1},
+
+// Field list for vsl::parse_strict_struct() and the key checks of from_json()
+#define VSL_DETAIL_JSON_STRICT_FIELDS(Specifier, Type, WithDefault, ...)                       \
+    Specifier constexpr auto vsl_json_strict_fields(const Type*)                                \
+    {                                                                                           \
+        using vsl_json_type = Type;                                                             \
+        return std::tuple{                                                                      \
+            NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(VSL_DETAIL_JSON_FIELD, __VA_ARGS__))};     \
+    }                                                                                           \
+    Specifier constexpr auto vsl_json_strict_with_default(const Type*) -> bool                  \
+    {                                                                                           \
+        return WithDefault;                                                                     \
+    }
 
 #define VSL_JSON_STRICT_INLINE(Type, ...)                                                       \
+    VSL_DETAIL_JSON_STRICT_FIELDS(friend, Type, false, __VA_ARGS__)                             \
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     friend void to_json(BasicJsonType& nlohmann_json_j, const Type& nlohmann_json_t)            \
     {                                                                                           \
@@ -76,13 +221,13 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     friend void from_json(const BasicJsonType& nlohmann_json_j, Type& nlohmann_json_t)          \
     {                                                                                           \
-        constexpr auto allowed_keys = std::array                                                \
-            {NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(VSL_DETAIL_JSON_KEY_STR, __VA_ARGS__))};  \
+        constexpr auto& allowed_keys = vsl::detail::JsonStrictStructInfo<Type>::key_index;      \
         vsl::detail::check_json_keys(nlohmann_json_j, allowed_keys);                            \
         NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__))              \
     }
 
 #define VSL_JSON_STRICT_INLINE_WITH_DEFAULT(Type, ...)                                          \
+    VSL_DETAIL_JSON_STRICT_FIELDS(friend, Type, true, __VA_ARGS__)                              \
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     friend void to_json(BasicJsonType& nlohmann_json_j, const Type& nlohmann_json_t)            \
     {                                                                                           \
@@ -91,14 +236,14 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     friend void from_json(const BasicJsonType& nlohmann_json_j, Type& nlohmann_json_t)          \
     {                                                                                           \
-        constexpr auto allowed_keys = std::array                                                \
-            {NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(VSL_DETAIL_JSON_KEY_STR, __VA_ARGS__))};  \
+        constexpr auto& allowed_keys = vsl::detail::JsonStrictStructInfo<Type>::key_index;      \
         vsl::detail::check_json_keys(nlohmann_json_j, allowed_keys);                            \
         const auto nlohmann_json_default_obj = Type{};                                          \
         NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM_WITH_DEFAULT, __VA_ARGS__)) \
     }
 
 #define VSL_JSON_STRICT(Type, ...)                                                              \
+    VSL_DETAIL_JSON_STRICT_FIELDS(inline, Type, false, __VA_ARGS__)                             \
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     void to_json(BasicJsonType& nlohmann_json_j, const Type& nlohmann_json_t)                   \
     {                                                                                           \
@@ -107,13 +252,13 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     void from_json(const BasicJsonType& nlohmann_json_j, Type& nlohmann_json_t)                 \
     {                                                                                           \
-        constexpr auto allowed_keys = std::array                                                \
-            {NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(VSL_DETAIL_JSON_KEY_STR, __VA_ARGS__))};  \
+        constexpr auto& allowed_keys = vsl::detail::JsonStrictStructInfo<Type>::key_index;      \
         vsl::detail::check_json_keys(nlohmann_json_j, allowed_keys);                            \
         NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__))              \
     }
 
 #define VSL_JSON_STRICT_WITH_DEFAULT(Type, ...)                                                 \
+    VSL_DETAIL_JSON_STRICT_FIELDS(inline, Type, true, __VA_ARGS__)                              \
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     void to_json(BasicJsonType& nlohmann_json_j, const Type& nlohmann_json_t)                   \
     {                                                                                           \
@@ -122,8 +267,7 @@ auto check_json_for_extra_keys(const InputJsonType& input, const ReferenceJsonTy
     template<vsl::detail::is_basic_json BasicJsonType>                                          \
     void from_json(const BasicJsonType& nlohmann_json_j, Type& nlohmann_json_t)                 \
     {                                                                                           \
-        constexpr auto allowed_keys = std::array                                                \
-            {NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(VSL_DETAIL_JSON_KEY_STR, __VA_ARGS__))};  \
+        constexpr auto& allowed_keys = vsl::detail::JsonStrictStructInfo<Type>::key_index;      \
         vsl::detail::check_json_keys(nlohmann_json_j, allowed_keys);                            \
         const auto nlohmann_json_default_obj = Type{};                                          \
         NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM_WITH_DEFAULT, __VA_ARGS__)) \
@@ -152,17 +296,7 @@ struct adl_serializer<T>
     template<typename JsonType>
     static void from_json(const JsonType& j, T& e)
     {
-        const auto name = j.template get<std::string_view>();
-        const auto value = vsl::enum_from_string_icase<T>(name);
-        if (value.has_value())
-        {
-            e = value.value();
-        }
-        else
-        {
-            const auto msg = fmt::format("Unknown enum value: {}", name);
-            throw json::type_error::create(302, msg, &j);
-        }
+        e = vsl::detail::enum_from_json_name<T>(j.template get<std::string_view>(), &j);
     }
 };
 
@@ -181,6 +315,381 @@ using json_type_error = nlohmann::json::type_error;
 using json_out_of_range = nlohmann::json::out_of_range;
 using json_other_error = nlohmann::json::other_error;
 
+namespace detail
+{
+
+// Filled element by element (std::vector<bool> has no element references)
+template<typename T>
+inline constexpr auto is_sax_vector = false;
+
+template<typename T, typename Allocator>
+inline constexpr auto is_sax_vector<std::vector<T, Allocator>> =
+    std::default_initializable<T> && !std::same_as<T, bool>;
+
+// SAX handler of BasicJsonType::sax_parse() filling a VSL_JSON_STRICT* struct without the DOM.
+// Strict structs and vectors are filled in place. Scalars are converted by from_json() of a single value json,
+// so the conversions and errors are the same as of the DOM path. Other objects and arrays (maps, non-strict
+// structs) are collected into a json and converted by from_json() when complete.
+template<is_basic_json BasicJsonType>
+class JsonStrictSaxParser final
+{
+  public:
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using binary_t = typename BasicJsonType::binary_t;
+
+    template<typename T>
+    explicit JsonStrictSaxParser(T& root)
+        : root_{make_slot(root)}
+    {}
+
+    JsonStrictSaxParser(const JsonStrictSaxParser&) = delete;
+    JsonStrictSaxParser& operator=(const JsonStrictSaxParser&) = delete;
+
+    ~JsonStrictSaxParser() = default;
+
+    auto null() -> bool
+    {
+        return value(BasicJsonType(nullptr));
+    }
+
+    auto boolean(bool val) -> bool
+    {
+        return value(BasicJsonType(val));
+    }
+
+    auto number_integer(number_integer_t val) -> bool
+    {
+        return value(BasicJsonType(val));
+    }
+
+    auto number_unsigned(number_unsigned_t val) -> bool
+    {
+        return value(BasicJsonType(val));
+    }
+
+    auto number_float(number_float_t val, const string_t&) -> bool
+    {
+        return value(BasicJsonType(val));
+    }
+
+    auto binary(binary_t& val) -> bool
+    {
+        return value(BasicJsonType::binary(std::move(val)));
+    }
+
+    auto string(string_t& val) -> bool
+    {
+        if (is_capturing())
+        {
+            capture_value(BasicJsonType(std::move(val)));
+        }
+        else
+        {
+            const auto slot = next_slot();
+            slot.ops->string(slot.target, val);
+        }
+        return true;
+    }
+
+    auto start_object(size_t) -> bool
+    {
+        if (is_capturing())
+        {
+            capture_stack_.push_back(capture_value(BasicJsonType(BasicJsonType::value_t::object)));
+        }
+        else
+        {
+            const auto slot = next_slot();
+            slot.ops->start_object(*this, slot.target);
+        }
+        return true;
+    }
+
+    auto key(string_t& val) -> bool
+    {
+        if (is_capturing())
+        {
+            capture_element_ = &(*capture_stack_.back())[val];
+        }
+        else
+        {
+            auto& frame = frames_.back();
+            field_slot_ = frame.ops->key(frame, val);
+        }
+        return true;
+    }
+
+    auto end_object() -> bool
+    {
+        return end_container();
+    }
+
+    auto start_array(size_t) -> bool
+    {
+        if (is_capturing())
+        {
+            capture_stack_.push_back(capture_value(BasicJsonType(BasicJsonType::value_t::array)));
+        }
+        else
+        {
+            const auto slot = next_slot();
+            slot.ops->start_array(*this, slot.target);
+        }
+        return true;
+    }
+
+    auto end_array() -> bool
+    {
+        return end_container();
+    }
+
+    template<typename Exception>
+    [[noreturn]]
+    auto parse_error(size_t, const std::string&, const Exception& ex) -> bool
+    {
+        throw ex;
+    }
+
+  private:
+    struct SlotOps;
+    struct FrameOps;
+
+    // Destination of the next value
+    struct Slot
+    {
+        void* target{};
+        const SlotOps* ops{};
+    };
+
+    struct SlotOps
+    {
+        void (*value)(void* target, BasicJsonType&& val);
+        void (*string)(void* target, string_t& val);
+        void (*start_object)(JsonStrictSaxParser& parser, void* target);
+        void (*start_array)(JsonStrictSaxParser& parser, void* target);
+    };
+
+    // Strict struct or vector being filled
+    struct Frame
+    {
+        void* target{};
+        const FrameOps* ops{};
+        uint64_t seen_fields{};
+    };
+
+    // key() is set for the structs, element() for the vectors
+    struct FrameOps
+    {
+        Slot (*key)(Frame& frame, const string_t& key);
+        Slot (*element)(void* target);
+        void (*end)(const Frame& frame);
+    };
+
+    template<typename T>
+    static auto make_slot(T& target) -> Slot
+    {
+        return Slot{&target, &slot_ops<T>};
+    }
+
+    template<typename T>
+    static auto assign_value(void* target, BasicJsonType&& val) -> void
+    {
+        auto& obj = *static_cast<T*>(target);
+        if constexpr (std::is_same_v<T, BasicJsonType>)
+        {
+            obj = std::move(val);
+        }
+        else
+        {
+            val.get_to(obj);
+        }
+    }
+
+    template<typename T>
+    static auto assign_string(void* target, string_t& val) -> void
+    {
+        if constexpr (std::is_same_v<T, string_t>)
+        {
+            *static_cast<T*>(target) = std::move(val);
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            *static_cast<T*>(target) = enum_from_json_name<T>(val, static_cast<const BasicJsonType*>(nullptr));
+        }
+        else
+        {
+            assign_value<T>(target, BasicJsonType(std::move(val)));
+        }
+    }
+
+    template<typename T>
+    static auto start_object(JsonStrictSaxParser& parser, void* target) -> void
+    {
+        if constexpr (json_strict_struct<T>)
+        {
+            // Missing fields get the defaults, as with from_json()
+            if constexpr (JsonStrictStructInfo<T>::with_default) *static_cast<T*>(target) = T{};
+            parser.frames_.push_back(Frame{.target = target, .ops = &struct_ops<T>});
+        }
+        else
+        {
+            parser.start_capture(Slot{target, &slot_ops<T>}, BasicJsonType::value_t::object);
+        }
+    }
+
+    template<typename T>
+    static auto start_array(JsonStrictSaxParser& parser, void* target) -> void
+    {
+        if constexpr (is_sax_vector<T>)
+        {
+            static_cast<T*>(target)->clear();
+            parser.frames_.push_back(Frame{.target = target, .ops = &vector_ops<T>});
+        }
+        else
+        {
+            parser.start_capture(Slot{target, &slot_ops<T>}, BasicJsonType::value_t::array);
+        }
+    }
+
+    template<typename T>
+    static auto struct_key(Frame& frame, const string_t& key) -> Slot
+    {
+        using info = JsonStrictStructInfo<T>;
+
+        const auto index = info::key_index.find(key);
+        if (!index.has_value()) throw_unknown_json_key(key, static_cast<const BasicJsonType*>(nullptr));
+
+        frame.seen_fields |= uint64_t{1} << index.value();
+        return field_slots<T>[index.value()](frame.target);
+    }
+
+    template<typename T>
+    static auto struct_end(const Frame& frame) -> void
+    {
+        using info = JsonStrictStructInfo<T>;
+
+        if constexpr (!info::with_default)
+        {
+            for (auto index = size_t{0}; index < info::field_count; ++index)
+            {
+                if ((frame.seen_fields & (uint64_t{1} << index)) == 0)
+                {
+                    const auto msg = fmt::format("key '{}' not found", info::keys[index]);
+                    throw BasicJsonType::out_of_range::create(403, msg, static_cast<const BasicJsonType*>(nullptr));
+                }
+            }
+        }
+    }
+
+    template<typename T, size_t Index>
+    static auto field_slot(void* target) -> Slot
+    {
+        constexpr auto field = std::get<Index>(JsonStrictStructInfo<T>::fields);
+        return make_slot(static_cast<T*>(target)->*field.member);
+    }
+
+    template<typename T>
+    static constexpr auto field_slots = []<size_t... Index>(std::index_sequence<Index...>)
+    {
+        return std::array<Slot (*)(void*), sizeof...(Index)>{&field_slot<T, Index>...};
+    }(std::make_index_sequence<JsonStrictStructInfo<T>::field_count>{});
+
+    template<typename T>
+    static auto vector_element(void* target) -> Slot
+    {
+        return make_slot(static_cast<T*>(target)->emplace_back());
+    }
+
+    template<typename T>
+    static constexpr auto slot_ops = SlotOps{&assign_value<T>, &assign_string<T>, &start_object<T>, &start_array<T>};
+
+    template<typename T>
+    static constexpr auto struct_ops = FrameOps{&struct_key<T>, nullptr, &struct_end<T>};
+
+    template<typename T>
+    static constexpr auto vector_ops = FrameOps{nullptr, &vector_element<T>, nullptr};
+
+    auto next_slot() -> Slot
+    {
+        if (frames_.empty()) return root_;
+
+        const auto& frame = frames_.back();
+        return frame.ops->element ? frame.ops->element(frame.target) : field_slot_;
+    }
+
+    auto value(BasicJsonType&& val) -> bool
+    {
+        if (is_capturing())
+        {
+            capture_value(std::move(val));
+        }
+        else
+        {
+            const auto slot = next_slot();
+            slot.ops->value(slot.target, std::move(val));
+        }
+        return true;
+    }
+
+    auto end_container() -> bool
+    {
+        if (is_capturing())
+        {
+            capture_stack_.pop_back();
+            if (capture_stack_.empty())
+            {
+                capture_slot_.ops->value(capture_slot_.target, std::move(capture_root_));
+            }
+        }
+        else
+        {
+            const auto& frame = frames_.back();
+            if (frame.ops->end) frame.ops->end(frame);
+            frames_.pop_back();
+        }
+        return true;
+    }
+
+    auto is_capturing() const -> bool
+    {
+        return !capture_stack_.empty();
+    }
+
+    auto start_capture(Slot slot, typename BasicJsonType::value_t type) -> void
+    {
+        capture_slot_ = slot;
+        capture_root_ = BasicJsonType(type);
+        capture_stack_.push_back(&capture_root_);
+    }
+
+    // Adds to the open array or to the last key of the open object
+    auto capture_value(BasicJsonType&& val) -> BasicJsonType*
+    {
+        auto& container = *capture_stack_.back();
+        if (container.is_array())
+        {
+            container.push_back(std::move(val));
+            return &container.back();
+        }
+        *capture_element_ = std::move(val);
+        return capture_element_;
+    }
+
+    Slot root_{};
+    Slot field_slot_{};
+    std::vector<Frame> frames_{};
+
+    Slot capture_slot_{};
+    BasicJsonType capture_root_{};
+    std::vector<BasicJsonType*> capture_stack_{};
+    BasicJsonType* capture_element_{};
+};
+
+}  // namespace detail
+
 enum class EnsureAscii
 {
     YES,
@@ -228,6 +737,33 @@ auto try_get_strict_struct_from_json(const JsonType& json) -> std::optional<Stru
     }
 }
 
+// Parses the input (string, stream, ...) straight into a VSL_JSON_STRICT* struct without building the JsonType DOM.
+// The result and the exceptions are the same as of JsonType::parse(input).get<StructType>(), except that the values
+// are checked as they are read, so an invalid value is reported before a syntax error further in the input.
+template<typename StructType, typename JsonType = Json, typename InputType>
+    requires detail::json_strict_struct<StructType>
+auto parse_strict_struct(InputType&& input) -> StructType
+{
+    auto res_struct = StructType{};
+    auto sax = detail::JsonStrictSaxParser<JsonType>{res_struct};
+    JsonType::sax_parse(std::forward<InputType>(input), &sax);
+    return res_struct;
+}
+
+template<typename StructType, typename JsonType = Json, typename InputType>
+    requires detail::json_strict_struct<StructType>
+auto try_parse_strict_struct(InputType&& input) -> std::optional<StructType>
+{
+    try
+    {
+        return parse_strict_struct<StructType, JsonType>(std::forward<InputType>(input));
+    }
+    catch (const json_exception&)
+    {
+        return std::nullopt;
+    }
+}
+
 template<typename JsonType>
 auto json_to_pretty_line(const JsonType& json, EnsureAscii ensure_ascii = EnsureAscii::NO) -> std::string
 {
@@ -5,11 +5,16 @@
 
 #include <fmt/format.h>
 
+#include <array>
 #include <compare>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <vector>
 
 using namespace testing;
 
@@ -123,6 +128,41 @@ struct PersonStrictWithDefault
     auto operator<=>(const PersonStrictWithDefault&) const = default;
 };
 
+enum class BookSide
+{
+    BUY,
+    SELL,
+};
+
+struct BookLevel
+{
+    double price;
+    int64_t qty;
+
+    auto operator<=>(const BookLevel&) const = default;
+};
+
+struct BookSettings
+{
+    int depth{10};
+    bool snapshot{true};
+
+    auto operator<=>(const BookSettings&) const = default;
+
+    VSL_JSON_STRICT_INLINE_WITH_DEFAULT(BookSettings, depth, snapshot)
+};
+
+struct Book
+{
+    std::string symbol;
+    BookSide side;
+    std::vector<BookLevel> levels;
+    std::map<std::string, int> tags;
+    BookSettings settings;
+
+    auto operator<=>(const Book&) const = default;
+};
+
 VSL_JSON(Person, name, age)
 VSL_JSON_WITH_DEFAULT(PersonWithDefault, name, age)
 VSL_JSON_ONLY_SERIALIZE(PersonNonDefaultConstructible, name, age)
@@ -130,6 +170,9 @@ VSL_JSON_ONLY_SERIALIZE(PersonNonDefaultConstructible, name, age)
 VSL_JSON_STRICT(PersonStrict, name, age)
 VSL_JSON_STRICT_WITH_DEFAULT(PersonStrictWithDefault, name, age)
 
+VSL_JSON_STRICT(BookLevel, price, qty)
+VSL_JSON_STRICT(Book, symbol, side, levels, tags, settings)
+
 static const auto PERSON_STRUCT_INLINE = PersonInline{.name = "John", .age = 20};
 static const auto PERSON_STRUCT_INLINE_DEF = PersonInlineWithDefault{.name = "John"};
 static const auto PERSON_STRUCT_INLINE_NDC = PersonInlineNonDefaultConstructible("John", 20);
@@ -389,6 +432,22 @@ TEST(JsonTest, CheckForExtraKeys)
     }
 }
 
+TEST(JsonTest, KeyIndex)
+{
+    constexpr auto keys =
+        std::array<std::string_view, 8>{"bid", "bid_px", "bid_qty", "ask", "ask_px", "ask_qty", "t", ""};
+    constexpr auto key_index = vsl::detail::JsonKeyIndex<keys.size()>{keys};
+    static_assert(key_index.find("ask_px") == 4);
+
+    for (auto i = size_t{0}; i < keys.size(); ++i)
+    {
+        EXPECT_THAT(key_index.find(keys[i]), Optional(i));
+    }
+    EXPECT_EQ(key_index.find("bid_p"), std::nullopt);
+    EXPECT_EQ(key_index.find("BID"), std::nullopt);
+    EXPECT_EQ(key_index.find("ts"), std::nullopt);
+}
+
 TEST(JsonTest, GetStrictStruct)
 {
     const auto json_ok = Json(PERSON_STRUCT);
@@ -409,6 +468,65 @@ TEST(JsonTest, GetStrictStruct)
     EXPECT_EQ(vsl::try_get_strict_struct_from_json<Person>(json_wrong_type), std::nullopt);
 }
 
+TEST(JsonTest, ParseStrictStruct)
+{
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrictInline>(PERSON_STR), PERSON_STRUCT_STRICT_INLINE);
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrict>(PERSON_STR), PERSON_STRUCT_STRICT);
+    EXPECT_EQ((vsl::parse_strict_struct<PersonStrict, OrderedJson>(PERSON_STR)), PERSON_STRUCT_STRICT);
+
+    std::stringstream ss;
+    ss << PERSON_STR;
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrict>(ss), PERSON_STRUCT_STRICT);
+
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrictInlineWithDefault>(PERSON_STR_PARTIAL),
+              PERSON_STRUCT_STRICT_INLINE_DEF);
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrictWithDefault>(PERSON_STR_PARTIAL), PERSON_STRUCT_STRICT_DEF);
+    EXPECT_EQ(vsl::parse_strict_struct<PersonStrictWithDefault>("null"), (PersonStrictWithDefault{}));
+
+    EXPECT_THROW(vsl::parse_strict_struct<PersonStrict>(PERSON_STR_PARTIAL), vsl::json_out_of_range);
+    EXPECT_THROW(vsl::parse_strict_struct<PersonStrict>(R"({"name":"John","age":20,"extra_key":0})"),
+                 vsl::json_out_of_range);
+    EXPECT_THROW(vsl::parse_strict_struct<PersonStrictWithDefault>(R"({"name":"John","extra_key":0})"),
+                 vsl::json_out_of_range);
+    EXPECT_THROW(vsl::parse_strict_struct<PersonStrict>(R"({"name":1,"age":20})"), vsl::json_type_error);
+    EXPECT_THROW(vsl::parse_strict_struct<PersonStrict>(R"({"name": "no closing quotes)"), vsl::json_parse_error);
+
+    EXPECT_THAT(vsl::try_parse_strict_struct<PersonStrict>(PERSON_STR), Optional(PERSON_STRUCT_STRICT));
+    EXPECT_EQ(vsl::try_parse_strict_struct<PersonStrict>(PERSON_STR_PARTIAL), std::nullopt);
+}
+
+TEST(JsonTest, ParseStrictStructNested)
+{
+    const auto book_str = R"({"symbol":"ABC","side":"Sell","tags":{"a":1,"b":2},"settings":{"depth":5},)"
+                          R"("levels":[{"price":1.5,"qty":100},{"qty":200,"price":1.25}]})";
+    const auto book = vsl::parse_strict_struct<Book>(book_str);
+
+    EXPECT_EQ(book, Json::parse(book_str).get<Book>());
+    EXPECT_EQ(book.side, BookSide::SELL);
+    EXPECT_EQ(book.levels, (std::vector<BookLevel>{{1.5, 100}, {1.25, 200}}));
+    EXPECT_EQ(book.settings, (BookSettings{.depth = 5}));
+
+    const auto book_empty = vsl::parse_strict_struct<Book>(
+        R"({"symbol":"","side":"BUY","levels":[],"tags":{},"settings":null})");
+    EXPECT_TRUE(book_empty.levels.empty());
+    EXPECT_EQ(book_empty.settings, BookSettings{});
+
+    const auto parse_with_levels = [](std::string_view levels)
+    {
+        const auto str = fmt::format(R"({{"symbol":"ABC","side":"BUY","tags":{{}},"settings":{{}},"levels":{}}})",
+                                     levels);
+        return vsl::parse_strict_struct<Book>(str);
+    };
+    EXPECT_EQ(parse_with_levels(R"([{"price":1,"qty":1}])").levels.size(), 1);
+    EXPECT_THROW(parse_with_levels(R"([{"price":1,"qty":1,"extra_key":0}])"), vsl::json_out_of_range);
+    EXPECT_THROW(parse_with_levels(R"([{"price":1}])"), vsl::json_out_of_range);
+    EXPECT_THROW(parse_with_levels(R"([{"price":"1","qty":1}])"), vsl::json_type_error);
+    EXPECT_THROW(parse_with_levels(R"({"price":1,"qty":1})"), vsl::json_type_error);
+
+    EXPECT_THROW(vsl::parse_strict_struct<Book>(R"({"symbol":"ABC","side":"BAD","levels":[],"tags":{},"settings":{}})"),
+                 vsl::json_type_error);
+}
+
 TEST(JsonTest, JsonToPrettyLine)
 {
     const auto json = Json::parse(PERSON_STR);
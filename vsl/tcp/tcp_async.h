@@ -0,0 +1,248 @@
+#ifndef VSL_TCP_TCP_ASYNC_H
+#define VSL_TCP_TCP_ASYNC_H
+
+#include "tcp_client.h"
+#include "tcp_epoll.h"
+#include "tcp_listener.h"
+#include "tcp_task.h"
+
+#include <vsl/concepts.h>
+#include <vsl/os.h>
+
+#if !defined(VSL_LINUX_OS)
+#error Async TCP API is supported on Linux only
+#endif
+
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+namespace detail
+{
+
+struct IoWaiter
+{
+    std::coroutine_handle<> handle{};
+    bool is_ready{false};
+};
+
+struct IoState
+{
+    IoWaiter reader{};
+    IoWaiter writer{};
+};
+
+class IoAwaiter
+{
+  public:
+    explicit IoAwaiter(IoWaiter& waiter) noexcept
+        : waiter_{waiter}
+    {}
+
+    auto await_ready() noexcept -> bool
+    {
+        return std::exchange(waiter_.is_ready, false);
+    }
+
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> void
+    {
+        waiter_.handle = handle;
+    }
+
+    auto await_resume() const noexcept -> void {}
+
+  private:
+    IoWaiter& waiter_;
+};
+
+class SpawnedTask;
+
+}  // namespace detail
+
+// Single-threaded epoll executor for coroutine based I/O (Linux only).
+// run() and all async operations must be used from one thread, stop() is thread-safe.
+class TcpExecutor final
+{
+  public:
+    TcpExecutor() = default;
+
+    TcpExecutor(const TcpExecutor&) = delete;
+    TcpExecutor& operator=(const TcpExecutor&) = delete;
+
+    ~TcpExecutor();
+
+    // The task starts on the next run() iteration
+    auto spawn(Task<void> task) -> void;
+
+    // Runs until all spawned tasks complete or stop() is called.
+    // An exception escaping a spawned task stops the loop and is rethrown.
+    auto run() -> void;
+    auto stop() -> void;
+
+    auto task_count() const -> size_t;
+
+  private:
+    friend class AsyncTcpClient;
+    friend class AsyncTcpListener;
+    friend class detail::SpawnedTask;
+
+    static inline constexpr auto MAX_EVENTS = 256;
+
+    auto run_spawned(Task<void> task) -> detail::SpawnedTask;
+
+    auto register_io(int fd) -> uint64_t;
+    auto unregister_io(int fd, uint64_t io_id) noexcept -> void;
+    auto wait_readable(uint64_t io_id) -> detail::IoAwaiter;
+    auto wait_writable(uint64_t io_id) -> detail::IoAwaiter;
+    auto wake(detail::IoWaiter& waiter) -> void;
+    auto resume_ready() -> void;
+
+    detail::Epoll epoll_{};
+    std::atomic_bool stop_requested_{false};
+
+    std::unordered_map<uint64_t, detail::IoState> io_states_{};
+    uint64_t next_io_id_{1};
+
+    std::vector<std::coroutine_handle<>> ready_{};
+    std::vector<std::coroutine_handle<>> resuming_{};
+    std::unordered_set<void*> tasks_{};  // Addresses of spawned coroutine frames
+    std::exception_ptr error_{};
+};
+
+// Coroutine counterpart of TcpClient with the same wire format (size prefixes, ByteOrder).
+// Unlike TcpClient, writes are sent when awaited, no flush is needed.
+// Buffers passed to async writes must stay valid until the write is awaited.
+class AsyncTcpClient final
+{
+  public:
+    explicit AsyncTcpClient(TcpExecutor& executor, TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE);
+
+    AsyncTcpClient(AsyncTcpClient&& other) noexcept;
+    AsyncTcpClient& operator=(AsyncTcpClient&& other) noexcept;
+
+    AsyncTcpClient(const AsyncTcpClient&) = delete;
+    AsyncTcpClient& operator=(const AsyncTcpClient&) = delete;
+
+    ~AsyncTcpClient();
+
+    auto async_connect(const std::pair<std::string, int>& endpoint) -> Task<void>;
+    auto async_connect(const std::string& host, int port) -> Task<void>;
+    auto async_connect(const std::string& endpoint) -> Task<void>;
+
+    auto shutdown(TcpClient::ShutdownType how = TcpClient::ShutdownType::BOTH) -> void;
+    auto close() -> void;
+
+    template<typename T>
+        requires vsl::numeric<T>
+    auto async_read() -> Task<T>;
+
+    template<typename T>
+        requires vsl::numeric<T>
+    auto async_write(T value) -> Task<void>;
+
+    template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto async_read_vector() -> Task<std::vector<ItemType>>;
+
+    template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto async_write_vector(const std::vector<ItemType>& vec) -> Task<void>;
+
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto async_read_string() -> Task<std::string>;
+
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto async_write_string(std::string_view str) -> Task<void>;
+
+    template<typename T, typename Size>
+    auto async_read_raw(T* buffer, Size length) -> Task<void>;
+
+    template<typename T, typename Size>
+    auto async_write_raw(const T* buffer, Size length) -> Task<void>;
+
+    auto is_active() const -> bool;
+
+    auto get_local_endpoint() const -> std::pair<std::string, int>;
+    auto get_remote_endpoint() const -> std::pair<std::string, int>;
+
+  private:
+    friend class AsyncTcpListener;
+
+    static inline constexpr auto READ_CHUNK_SIZE = size_t{16 * 1024};
+
+    AsyncTcpClient(TcpExecutor& executor, Poco::Net::StreamSocket socket, TcpClient::ByteOrder byte_order);
+
+    auto async_connect(Poco::Net::SocketAddress socket_addr) -> Task<void>;
+    auto unregister_io() noexcept -> void;
+
+    auto take_buffered(std::byte* data, size_t size) noexcept -> size_t;
+    auto receive_some(std::byte* data, size_t size) -> size_t;
+    auto async_receive(std::byte* data, size_t size) -> Task<void>;
+    auto async_send(std::span<const std::byte> head, std::span<const std::byte> body) -> Task<void>;
+
+    template<typename SizeType>
+    auto encode_size(size_t size) const -> std::array<std::byte, sizeof(typename SizeType::type)>;
+
+    TcpExecutor* executor_;
+    Poco::Net::StreamSocket socket_;
+    std::endian byte_order_;
+    uint64_t io_id_{0};
+
+    std::vector<std::byte> in_buffer_{};
+    size_t in_begin_{0};
+    size_t in_end_{0};
+};
+
+class AsyncTcpListener final
+{
+  public:
+    explicit AsyncTcpListener(TcpExecutor& executor);
+
+    AsyncTcpListener(const AsyncTcpListener&) = delete;
+    AsyncTcpListener& operator=(const AsyncTcpListener&) = delete;
+
+    ~AsyncTcpListener();
+
+    auto start(int port) -> void;
+    auto start(const std::pair<std::string, int>& endpoint) -> void;
+    auto start(const std::string& ip, int port) -> void;
+    auto start(const std::string& endpoint) -> void;
+    auto stop() -> void;
+
+    auto async_accept_client(TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE) -> Task<AsyncTcpClient>;
+
+    auto get_port() -> int;
+    auto is_listening() const -> bool;
+
+  private:
+    auto register_listener() -> void;
+
+    TcpExecutor& executor_;
+    TcpListener listener_{};
+    uint64_t io_id_{0};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_async_impl.h"
+
+#endif  // VSL_TCP_TCP_ASYNC_H
@@ -0,0 +1,681 @@
+#ifndef VSL_TCP_TCP_ASYNC_IMPL_H
+#define VSL_TCP_TCP_ASYNC_IMPL_H
+
+#include "tcp_byte_order.h"
+
+#include <vsl/concepts.h>
+#include <vsl/scope_guard.h>
+#include <vsl/types.h>
+
+#include <Poco/Exception.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+namespace detail
+{
+
+// Top-level coroutine of a spawned task, destroys itself on completion
+class SpawnedTask
+{
+  public:
+    class promise_type
+    {
+      public:
+        promise_type(TcpExecutor& executor, Task<void>&) noexcept
+            : executor_{executor}
+        {}
+
+        auto get_return_object() noexcept -> SpawnedTask
+        {
+            return SpawnedTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct FinalAwaiter
+            {
+                TcpExecutor& executor;
+
+                auto await_ready() const noexcept -> bool
+                {
+                    return false;
+                }
+
+                auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept -> void
+                {
+                    executor.tasks_.erase(handle.address());
+                    handle.destroy();
+                }
+
+                auto await_resume() const noexcept -> void {}
+            };
+
+            return FinalAwaiter{executor_};
+        }
+
+        auto return_void() noexcept -> void {}
+
+        auto unhandled_exception() noexcept -> void
+        {
+            if (!executor_.error_) executor_.error_ = std::current_exception();
+        }
+
+      private:
+        TcpExecutor& executor_;
+    };
+
+    explicit SpawnedTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_{handle}
+    {}
+
+    auto handle() const noexcept -> std::coroutine_handle<>
+    {
+        return handle_;
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+}  // namespace detail
+
+inline TcpExecutor::~TcpExecutor()
+{
+    for (auto* address : std::exchange(tasks_, {}))
+    {
+        std::coroutine_handle<>::from_address(address).destroy();
+    }
+}
+
+inline auto TcpExecutor::spawn(Task<void> task) -> void
+{
+    auto handle = run_spawned(std::move(task)).handle();
+    tasks_.insert(handle.address());
+    ready_.push_back(handle);
+}
+
+inline auto TcpExecutor::run_spawned(Task<void> task) -> detail::SpawnedTask
+{
+    co_await std::move(task);
+}
+
+inline auto TcpExecutor::run() -> void
+{
+    VSL_SCOPE_GUARD
+    {
+        stop_requested_.store(false);
+    };
+
+    auto events = std::array<epoll_event, MAX_EVENTS>{};
+
+    while (!stop_requested_.load())
+    {
+        resume_ready();
+
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        if (tasks_.empty()) break;
+
+        for (const auto& event : epoll_.wait(events, -1))
+        {
+            auto it = io_states_.find(event.data.u64);
+            if (it == io_states_.end()) continue;
+
+            auto& state = it->second;
+            if ((event.events & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) != 0) wake(state.reader);
+            if ((event.events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) != 0) wake(state.writer);
+        }
+    }
+}
+
+inline auto TcpExecutor::stop() -> void
+{
+    stop_requested_.store(true);
+    epoll_.wakeup();
+}
+
+inline auto TcpExecutor::task_count() const -> size_t
+{
+    return tasks_.size();
+}
+
+// Edge-triggered: the awaiters retry the operation before suspending
+inline auto TcpExecutor::register_io(int fd) -> uint64_t
+{
+    auto io_id = next_io_id_++;
+    io_states_.emplace(io_id, detail::IoState{});
+    epoll_.add(fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, io_id);
+    return io_id;
+}
+
+// Suspended waiters are resumed to observe the closed socket
+inline auto TcpExecutor::unregister_io(int fd, uint64_t io_id) noexcept -> void
+{
+    epoll_.remove(fd);
+
+    auto it = io_states_.find(io_id);
+    if (it == io_states_.end()) return;
+
+    for (auto* waiter : {&it->second.reader, &it->second.writer})
+    {
+        if (waiter->handle) ready_.push_back(std::exchange(waiter->handle, nullptr));
+    }
+    io_states_.erase(it);
+}
+
+inline auto TcpExecutor::wait_readable(uint64_t io_id) -> detail::IoAwaiter
+{
+    return detail::IoAwaiter{io_states_.at(io_id).reader};
+}
+
+inline auto TcpExecutor::wait_writable(uint64_t io_id) -> detail::IoAwaiter
+{
+    return detail::IoAwaiter{io_states_.at(io_id).writer};
+}
+
+inline auto TcpExecutor::wake(detail::IoWaiter& waiter) -> void
+{
+    if (waiter.handle)
+    {
+        ready_.push_back(std::exchange(waiter.handle, nullptr));
+    }
+    else
+    {
+        waiter.is_ready = true;
+    }
+}
+
+inline auto TcpExecutor::resume_ready() -> void
+{
+    while (!ready_.empty())
+    {
+        std::swap(ready_, resuming_);
+        for (auto handle : resuming_)
+        {
+            handle.resume();
+        }
+        resuming_.clear();
+    }
+}
+
+inline AsyncTcpClient::AsyncTcpClient(TcpExecutor& executor, TcpClient::ByteOrder byte_order)
+    : AsyncTcpClient{executor, Poco::Net::StreamSocket{}, byte_order}
+{}
+
+inline AsyncTcpClient::AsyncTcpClient(TcpExecutor& executor,
+                                      Poco::Net::StreamSocket socket,
+                                      TcpClient::ByteOrder byte_order)
+    : executor_{&executor},
+      socket_{std::move(socket)},
+      byte_order_{detail::to_endian(byte_order)}
+{
+    if (socket_.impl()->initialized())
+    {
+        io_id_ = executor_->register_io(socket_.impl()->sockfd());
+    }
+}
+
+inline AsyncTcpClient::AsyncTcpClient(AsyncTcpClient&& other) noexcept
+    : executor_{other.executor_},
+      socket_{std::move(other.socket_)},
+      byte_order_{other.byte_order_},
+      io_id_{std::exchange(other.io_id_, 0)},
+      in_buffer_{std::move(other.in_buffer_)},
+      in_begin_{std::exchange(other.in_begin_, 0)},
+      in_end_{std::exchange(other.in_end_, 0)}
+{}
+
+inline auto AsyncTcpClient::operator=(AsyncTcpClient&& other) noexcept -> AsyncTcpClient&
+{
+    if (this != &other)
+    {
+        unregister_io();
+
+        executor_ = other.executor_;
+        socket_ = std::move(other.socket_);
+        byte_order_ = other.byte_order_;
+        io_id_ = std::exchange(other.io_id_, 0);
+        in_buffer_ = std::move(other.in_buffer_);
+        in_begin_ = std::exchange(other.in_begin_, 0);
+        in_end_ = std::exchange(other.in_end_, 0);
+    }
+    return *this;
+}
+
+inline AsyncTcpClient::~AsyncTcpClient()
+{
+    unregister_io();
+}
+
+inline auto AsyncTcpClient::unregister_io() noexcept -> void
+{
+    if (io_id_ != 0)
+    {
+        executor_->unregister_io(socket_.impl()->sockfd(), std::exchange(io_id_, 0));
+    }
+}
+
+inline auto AsyncTcpClient::async_connect(const std::pair<std::string, int>& endpoint) -> Task<void>
+{
+    return async_connect(endpoint.first, endpoint.second);
+}
+
+inline auto AsyncTcpClient::async_connect(const std::string& host, int port) -> Task<void>
+{
+    auto socket_addr = Poco::Net::SocketAddress{};
+    try
+    {
+        socket_addr = Poco::Net::SocketAddress{host, vsl::checked_cast<uint16_t>(port)};
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Connection failed", ex.displayText()};
+    }
+    return async_connect(socket_addr);
+}
+
+inline auto AsyncTcpClient::async_connect(const std::string& endpoint) -> Task<void>
+{
+    auto socket_addr = Poco::Net::SocketAddress{};
+    try
+    {
+        socket_addr = Poco::Net::SocketAddress{endpoint};
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Connection failed", ex.displayText()};
+    }
+    return async_connect(socket_addr);
+}
+
+inline auto AsyncTcpClient::async_connect(Poco::Net::SocketAddress socket_addr) -> Task<void>
+{
+    try
+    {
+        socket_.connectNB(socket_addr);
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Connection failed", ex.displayText()};
+    }
+
+    io_id_ = executor_->register_io(socket_.impl()->sockfd());
+    co_await executor_->wait_writable(io_id_);
+
+    if (auto error_code = socket_.impl()->socketError(); error_code != 0)
+    {
+        close();
+        throw TcpClientError{"Connection failed", std::generic_category().message(error_code)};
+    }
+
+    socket_.setNoDelay(true);
+}
+
+inline auto AsyncTcpClient::shutdown(TcpClient::ShutdownType how) -> void
+{
+    try
+    {
+        switch (how)
+        {
+        case TcpClient::ShutdownType::BOTH:
+            socket_.shutdown();
+            break;
+        case TcpClient::ShutdownType::RECEIVE:
+            socket_.shutdownReceive();
+            break;
+        case TcpClient::ShutdownType::SEND:
+            socket_.shutdownSend();
+            break;
+        }
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Failed to shutdown connection", ex.displayText()};
+    }
+}
+
+inline auto AsyncTcpClient::close() -> void
+{
+    unregister_io();
+    in_begin_ = 0;
+    in_end_ = 0;
+
+    try
+    {
+        socket_.close();
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Failed to close connection", ex.displayText()};
+    }
+}
+
+template<typename T>
+    requires vsl::numeric<T>
+auto AsyncTcpClient::async_read() -> Task<T>
+{
+    auto bytes = std::array<std::byte, sizeof(T)>{};
+    co_await async_receive(bytes.data(), bytes.size());
+    if constexpr (std::same_as<T, bool>)
+    {
+        co_return detail::load<uint8_t>(bytes.data(), byte_order_) != 0;
+    }
+    else
+    {
+        co_return detail::load<T>(bytes.data(), byte_order_);
+    }
+}
+
+template<typename T>
+    requires vsl::numeric<T>
+auto AsyncTcpClient::async_write(T value) -> Task<void>
+{
+    auto bytes = std::array<std::byte, sizeof(T)>{};
+    detail::store(bytes.data(), value, byte_order_);
+    co_await async_send(bytes, {});
+}
+
+template<vsl::numeric ItemType, typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto AsyncTcpClient::async_read_vector() -> Task<std::vector<ItemType>>
+{
+    auto size = co_await async_read<typename SizeType::type>();
+    auto vec = std::vector<ItemType>{};
+    vec.resize(vsl::checked_cast<size_t>(size));
+
+    co_await async_read_raw(vec.data(), vec.size());
+    if (byte_order_ != std::endian::native) detail::byteswap_items(std::span{vec});
+
+    co_return vec;
+}
+
+template<vsl::numeric ItemType, typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto AsyncTcpClient::async_write_vector(const std::vector<ItemType>& vec) -> Task<void>
+{
+    auto size_prefix = encode_size<SizeType>(vec.size());
+    if (byte_order_ == std::endian::native)
+    {
+        co_await async_send(size_prefix, std::as_bytes(std::span{vec}));
+        co_return;
+    }
+
+    auto converted = vec;
+    detail::byteswap_items(std::span{converted});
+    co_await async_send(size_prefix, std::as_bytes(std::span{converted}));
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto AsyncTcpClient::async_read_string() -> Task<std::string>
+{
+    auto size = co_await async_read<typename SizeType::type>();
+    auto str = std::string{};
+    str.resize(vsl::checked_cast<size_t>(size));
+
+    co_await async_read_raw(str.data(), str.size());
+
+    co_return str;
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto AsyncTcpClient::async_write_string(std::string_view str) -> Task<void>
+{
+    auto size_prefix = encode_size<SizeType>(str.size());
+    co_await async_send(size_prefix, std::as_bytes(std::span{str}));
+}
+
+template<typename T, typename Size>
+auto AsyncTcpClient::async_read_raw(T* buffer, Size length) -> Task<void>
+{
+    auto data_ptr = reinterpret_cast<std::byte*>(buffer);
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+    return async_receive(data_ptr, data_size);
+}
+
+template<typename T, typename Size>
+auto AsyncTcpClient::async_write_raw(const T* buffer, Size length) -> Task<void>
+{
+    auto data_ptr = reinterpret_cast<const std::byte*>(buffer);
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+    return async_send({}, std::span{data_ptr, data_size});
+}
+
+template<typename SizeType>
+auto AsyncTcpClient::encode_size(size_t size) const -> std::array<std::byte, sizeof(typename SizeType::type)>
+{
+    auto bytes = std::array<std::byte, sizeof(typename SizeType::type)>{};
+    detail::store(bytes.data(), vsl::checked_cast<typename SizeType::type>(size), byte_order_);
+    return bytes;
+}
+
+inline auto AsyncTcpClient::take_buffered(std::byte* data, size_t size) noexcept -> size_t
+{
+    auto taken = std::min(size, in_end_ - in_begin_);
+    if (taken == 0) return 0;
+
+    std::memcpy(data, in_buffer_.data() + in_begin_, taken);
+    in_begin_ += taken;
+    if (in_begin_ == in_end_)
+    {
+        in_begin_ = 0;
+        in_end_ = 0;
+    }
+    return taken;
+}
+
+// Returns 0 if the socket has no data yet
+inline auto AsyncTcpClient::receive_some(std::byte* data, size_t size) -> size_t
+{
+    while (true)
+    {
+        auto received_count = ::recv(socket_.impl()->sockfd(), data, size, 0);
+        if (received_count > 0) return vsl::as_unsigned(received_count);
+        if (received_count == 0) throw TcpClientGracefulShutdown{};
+
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        detail::throw_client_error();
+    }
+}
+
+inline auto AsyncTcpClient::async_receive(std::byte* data, size_t size) -> Task<void>
+{
+    auto taken = take_buffered(data, size);
+    data += taken;
+    size -= taken;
+
+    while (size > 0)
+    {
+        // Large reads go directly to the destination, small ones through the receive buffer
+        auto received_count = size_t{0};
+        if (size >= READ_CHUNK_SIZE)
+        {
+            received_count = receive_some(data, size);
+            data += received_count;
+            size -= received_count;
+        }
+        else
+        {
+            if (in_buffer_.size() < READ_CHUNK_SIZE) in_buffer_.resize(READ_CHUNK_SIZE);
+
+            received_count = receive_some(in_buffer_.data(), in_buffer_.size());
+            in_end_ = received_count;
+            taken = take_buffered(data, size);
+            data += taken;
+            size -= taken;
+        }
+
+        if (received_count == 0)
+        {
+            if (io_id_ == 0) throw TcpClientError{"Socket is closed"};
+            co_await executor_->wait_readable(io_id_);
+        }
+    }
+}
+
+inline auto AsyncTcpClient::async_send(std::span<const std::byte> head, std::span<const std::byte> body)
+    -> Task<void>
+{
+    while (!head.empty() || !body.empty())
+    {
+        auto parts = std::array<iovec, 2>{};
+        auto part_count = size_t{0};
+        for (auto part : {head, body})
+        {
+            if (!part.empty()) parts[part_count++] = iovec{const_cast<std::byte*>(part.data()), part.size()};
+        }
+
+        auto message = msghdr{};
+        message.msg_iov = parts.data();
+        message.msg_iovlen = part_count;
+
+        auto sent_count = ::sendmsg(socket_.impl()->sockfd(), &message, MSG_NOSIGNAL);
+        if (sent_count < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) detail::throw_client_error();
+            if (io_id_ == 0) throw TcpClientError{"Socket is closed"};
+
+            co_await executor_->wait_writable(io_id_);
+            continue;
+        }
+
+        auto sent_size = vsl::as_unsigned(sent_count);
+        auto head_sent_size = std::min(sent_size, head.size());
+        head = head.subspan(head_sent_size);
+        body = body.subspan(sent_size - head_sent_size);
+    }
+}
+
+inline auto AsyncTcpClient::is_active() const -> bool
+{
+    return socket_.impl()->initialized();
+}
+
+inline auto AsyncTcpClient::get_local_endpoint() const -> std::pair<std::string, int>
+{
+    auto socket_addr = socket_.address();
+    return std::pair{socket_addr.host().toString(), socket_addr.port()};
+}
+
+inline auto AsyncTcpClient::get_remote_endpoint() const -> std::pair<std::string, int>
+{
+    auto socket_addr = socket_.peerAddress();
+    return std::pair{socket_addr.host().toString(), socket_addr.port()};
+}
+
+inline AsyncTcpListener::AsyncTcpListener(TcpExecutor& executor)
+    : executor_{executor}
+{}
+
+inline AsyncTcpListener::~AsyncTcpListener()
+{
+    if (io_id_ != 0)
+    {
+        executor_.unregister_io(listener_.server_socket_.impl()->sockfd(), io_id_);
+    }
+}
+
+inline auto AsyncTcpListener::start(int port) -> void
+{
+    listener_.start(port);
+    register_listener();
+}
+
+inline auto AsyncTcpListener::start(const std::pair<std::string, int>& endpoint) -> void
+{
+    listener_.start(endpoint);
+    register_listener();
+}
+
+inline auto AsyncTcpListener::start(const std::string& ip, int port) -> void
+{
+    listener_.start(ip, port);
+    register_listener();
+}
+
+inline auto AsyncTcpListener::start(const std::string& endpoint) -> void
+{
+    listener_.start(endpoint);
+    register_listener();
+}
+
+inline auto AsyncTcpListener::register_listener() -> void
+{
+    auto& server_socket = listener_.server_socket_;
+    server_socket.setBlocking(false);
+    io_id_ = executor_.register_io(server_socket.impl()->sockfd());
+}
+
+inline auto AsyncTcpListener::stop() -> void
+{
+    if (io_id_ != 0)
+    {
+        executor_.unregister_io(listener_.server_socket_.impl()->sockfd(), std::exchange(io_id_, 0));
+    }
+    listener_.stop();
+}
+
+inline auto AsyncTcpListener::async_accept_client(TcpClient::ByteOrder byte_order) -> Task<AsyncTcpClient>
+{
+    while (true)
+    {
+        if (io_id_ == 0) throw TcpListenerError{"Failed to accept client", "Not listening"};
+
+        auto fd = accept4(listener_.server_socket_.impl()->sockfd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0)
+        {
+            auto socket = detail::wrap_socket_fd(fd);
+            socket.setNoDelay(true);
+            co_return AsyncTcpClient{executor_, std::move(socket), byte_order};
+        }
+
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) detail::throw_system_error("Failed to accept client");
+
+        co_await executor_.wait_readable(io_id_);
+    }
+}
+
+inline auto AsyncTcpListener::get_port() -> int
+{
+    return listener_.get_port();
+}
+
+inline auto AsyncTcpListener::is_listening() const -> bool
+{
+    return listener_.is_listening();
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_ASYNC_IMPL_H
@@ -1,7 +1,11 @@
 #ifndef VSL_TCP_TCP_BUFFER_H
 #define VSL_TCP_TCP_BUFFER_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <span>
 #include <streambuf>
 #include <vector>
@@ -9,47 +13,137 @@
 namespace vsl::tcp
 {
 
+namespace detail
+{
+
+// Process-wide free list of fixed size buffer chunks shared by all the clients, keeps up to MAX_POOLED_SIZE bytes
+class BufferChunkPool final
+{
+  public:
+    using Chunk = std::unique_ptr<char[]>;
+
+    static inline constexpr auto CHUNK_SIZE = size_t{4096};
+    static inline constexpr auto MAX_POOLED_SIZE = size_t{64 * 1024 * 1024};
+
+    static auto instance() -> BufferChunkPool&
+    {
+        static auto pool = BufferChunkPool{};
+        return pool;
+    }
+
+    auto acquire() -> Chunk
+    {
+        {
+            auto _ = std::scoped_lock(mutex_);
+            if (!free_chunks_.empty())
+            {
+                auto chunk = std::move(free_chunks_.back());
+                free_chunks_.pop_back();
+                return chunk;
+            }
+        }
+        return std::make_unique_for_overwrite<char[]>(CHUNK_SIZE);
+    }
+
+    auto release(Chunk chunk) noexcept -> void
+    {
+        try
+        {
+            auto _ = std::scoped_lock(mutex_);
+            if (free_chunks_.size() < MAX_POOLED_SIZE / CHUNK_SIZE)
+            {
+                free_chunks_.push_back(std::move(chunk));
+            }
+        }
+        catch (...)
+        {
+        }
+    }
+
+    auto pooled_count() const -> size_t
+    {
+        auto _ = std::scoped_lock(mutex_);
+        return free_chunks_.size();
+    }
+
+  private:
+    BufferChunkPool() = default;
+
+    mutable std::mutex mutex_{};
+    std::vector<Chunk> free_chunks_{};
+};
+
+}  // namespace detail
+
+// Write buffer made of pooled fixed size chunks, the put area is the current chunk, so writes are plain copies
+// and overflow() is called once per chunk. The first chunk is taken by the first write and clearing returns
+// all of them to the pool (a client that does not buffer holds no chunks).
 class VectorStreamBuf : public std::streambuf
 {
   public:
-    VectorStreamBuf()
+    using Chunk = detail::BufferChunkPool::Chunk;
+
+    static inline constexpr auto CHUNK_SIZE = detail::BufferChunkPool::CHUNK_SIZE;
+
+    VectorStreamBuf() = default;
+
+    VectorStreamBuf(const VectorStreamBuf&) = delete;
+    VectorStreamBuf& operator=(const VectorStreamBuf&) = delete;
+
+    ~VectorStreamBuf() override
     {
-        vec_.reserve(INITIAL_RESERVE_SIZE);
+        release_chunks(0);
     }
 
-    auto get_span() const -> std::span<const char>
+    // Calls func(std::span<const char>) for each filled part of the buffer in order
+    template<typename Func>
+    auto for_each_span(Func func) const -> void
     {
-        return std::span{vec_};
+        auto remaining = buffer_size();
+        for (auto i = size_t{0}; remaining > 0; ++i)
+        {
+            auto size = std::min(remaining, CHUNK_SIZE);
+            func(std::span<const char>{chunks_[i].get(), size});
+            remaining -= size;
+        }
     }
 
     auto buffer_size() const -> size_t
     {
-        return vec_.size();
+        return current_chunk_ * CHUNK_SIZE + static_cast<size_t>(pptr() - pbase());
     }
 
     auto buffer_empty() const -> bool
     {
-        return vec_.empty();
+        return buffer_size() == 0;
     }
 
     auto buffer_capacity() const -> size_t
     {
-        return vec_.capacity();
+        return chunks_.size() * CHUNK_SIZE;
     }
 
     auto reserve_buffer(size_t capacity) -> void
     {
-        vec_.reserve(capacity);
+        while (buffer_capacity() < capacity)
+        {
+            chunks_.push_back(detail::BufferChunkPool::instance().acquire());
+        }
+        if (pbase() == nullptr) reset_put_area();
     }
 
     auto shrink_buffer_to_fit() -> void
     {
-        vec_.shrink_to_fit();
+        auto used_count = buffer_empty() ? 0 : current_chunk_ + 1;
+        release_chunks(used_count);
+        if (used_count == 0) reset_put_area();
     }
 
     auto clear_buffer() -> void
     {
-        vec_.clear();
+        current_chunk_ = 0;
+        release_chunks(0);
+        reset_put_area();
     }
 
   protected:
@@ -60,20 +154,259 @@ class VectorStreamBuf : public std::streambuf
             return traits_type::not_eof(ch);
         }
 
-        vec_.push_back(traits_type::to_char_type(ch));
+        next_chunk();
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
         return ch;
     }
 
     std::streamsize xsputn(const char* s, std::streamsize n) override
     {
-        vec_.insert(vec_.end(), s, s + n);
+        auto remaining = static_cast<size_t>(n);
+        while (remaining > 0)
+        {
+            if (pptr() == epptr()) next_chunk();
+
+            auto count = std::min(remaining, static_cast<size_t>(epptr() - pptr()));
+            std::memcpy(pptr(), s, count);
+            pbump(static_cast<int>(count));
+            s += count;
+            remaining -= count;
+        }
         return n;
     }
 
   private:
-    static inline constexpr auto INITIAL_RESERVE_SIZE = 1024;
+    // Called with a full (or not yet set) put area only
+    auto next_chunk() -> void
+    {
+        if (pbase() != nullptr) ++current_chunk_;
+        if (current_chunk_ == chunks_.size())
+        {
+            chunks_.push_back(detail::BufferChunkPool::instance().acquire());
+        }
+        auto chunk = chunks_[current_chunk_].get();
+        setp(chunk, chunk + CHUNK_SIZE);
+    }
+
+    auto reset_put_area() -> void
+    {
+        if (chunks_.empty())
+        {
+            setp(nullptr, nullptr);
+            return;
+        }
+        auto chunk = chunks_[current_chunk_].get();
+        setp(chunk, chunk + CHUNK_SIZE);
+    }
+
+    auto release_chunks(size_t keep_count) -> void
+    {
+        while (chunks_.size() > keep_count)
+        {
+            detail::BufferChunkPool::instance().release(std::move(chunks_.back()));
+            chunks_.pop_back();
+        }
+    }
+
+    std::vector<Chunk> chunks_{};
+    size_t current_chunk_{0};
+};
+
+// Receive buffer with read/write positions. Instead of wrapping around, unread bytes are moved
+// to the front when space is needed, so a received frame is always one contiguous span.
+// Consumed bytes stay intact until the next prepare().
+class ReceiveBuffer
+{
+  public:
+    auto data() const -> const std::byte*
+    {
+        return vec_.data() + begin_;
+    }
+
+    auto size() const -> size_t
+    {
+        return end_ - begin_;
+    }
+
+    auto empty() const -> bool
+    {
+        return begin_ == end_;
+    }
+
+    auto capacity() const -> size_t
+    {
+        return vec_.size();
+    }
+
+    // Returns a writable span of at least min_size bytes after the unread data
+    auto prepare(size_t min_size) -> std::span<std::byte>
+    {
+        if (vec_.size() - end_ < min_size)
+        {
+            if (begin_ > 0)
+            {
+                std::memmove(vec_.data(), vec_.data() + begin_, size());
+                end_ -= begin_;
+                begin_ = 0;
+            }
+            if (vec_.size() - end_ < min_size)
+            {
+                vec_.resize(std::max(end_ + min_size, vec_.size() * 2));
+            }
+        }
+        return std::span{vec_}.subspan(end_);
+    }
+
+    auto commit(size_t count) -> void
+    {
+        end_ += count;
+    }
+
+    auto consume(size_t count) -> void
+    {
+        begin_ += count;
+        if (begin_ == end_)
+        {
+            begin_ = 0;
+            end_ = 0;
+        }
+    }
+
+    auto take(std::byte* dest, size_t count) -> size_t
+    {
+        count = std::min(count, size());
+        if (count > 0)
+        {
+            std::memcpy(dest, data(), count);
+            consume(count);
+        }
+        return count;
+    }
+
+  private:
+    std::vector<std::byte> vec_{};
+    size_t begin_{0};
+    size_t end_{0};
+};
+
+// Write buffer for gather (writev) sends: small writes are copied into an arena,
+// large ones are referenced in place and must stay valid until the buffer is sent
+class GatherBuffer
+{
+  public:
+    auto append(const std::byte* data, size_t size) -> void
+    {
+        if (size < MIN_REFERENCE_SIZE)
+        {
+            append_copy(data, size);
+            return;
+        }
+
+        segments_.push_back(Segment{data, 0, size});
+        size_ += size;
+    }
+
+    // Always copies, for data that does not outlive the call
+    auto append_copy(const std::byte* data, size_t size) -> void
+    {
+        if (size == 0) return;
+
+        auto arena_offset = arena_.size();
+        arena_.insert(arena_.end(), data, data + size);
+        size_ += size;
+
+        // Adjacent copies share one segment
+        if (!segments_.empty())
+        {
+            auto& last = segments_.back();
+            if (last.data == nullptr && last.arena_offset + last.size == arena_offset)
+            {
+                last.size += size;
+                return;
+            }
+        }
+        segments_.push_back(Segment{nullptr, arena_offset, size});
+    }
+
+    auto size() const -> size_t
+    {
+        return size_;
+    }
+
+    auto empty() const -> bool
+    {
+        return size_ == 0;
+    }
+
+    // Calls func(std::span<const std::span<const std::byte>>) with up to max_count pieces,
+    // func returns the number of bytes consumed
+    template<typename Func>
+    auto consume(size_t max_count, Func func) -> void
+    {
+        auto pieces = std::vector<std::span<const std::byte>>{};
+        while (!empty())
+        {
+            pieces.clear();
+            for (auto i = first_segment_; i < segments_.size() && pieces.size() < max_count; ++i)
+            {
+                pieces.push_back(segment_data(segments_[i]));
+            }
+            advance(func(std::span<const std::span<const std::byte>>{pieces}));
+        }
+        clear();
+    }
+
+    auto clear() -> void
+    {
+        segments_.clear();
+        arena_.clear();
+        first_segment_ = 0;
+        size_ = 0;
+    }
+
+  private:
+    static inline constexpr auto MIN_REFERENCE_SIZE = size_t{256};
+
+    // Arena segments store an offset, the arena may be reallocated while appending
+    struct Segment
+    {
+        const std::byte* data;
+        size_t arena_offset;
+        size_t size;
+    };
+
+    auto segment_data(const Segment& segment) const -> std::span<const std::byte>
+    {
+        auto data = (segment.data != nullptr) ? segment.data : arena_.data() + segment.arena_offset;
+        return std::span{data, segment.size};
+    }
+
+    auto advance(size_t count) -> void
+    {
+        size_ -= count;
+        while (count > 0)
+        {
+            auto& segment = segments_[first_segment_];
+            auto step = std::min(count, segment.size);
+            if (segment.data != nullptr)
+            {
+                segment.data += step;
+            }
+            else
+            {
+                segment.arena_offset += step;
+            }
+            segment.size -= step;
+            count -= step;
+            if (segment.size == 0) ++first_segment_;
+        }
+    }
 
-    std::vector<char> vec_{};
+    std::vector<Segment> segments_{};
+    std::vector<std::byte> arena_{};
+    size_t first_segment_{0};
+    size_t size_{0};
 };
 
 }  // namespace vsl::tcp
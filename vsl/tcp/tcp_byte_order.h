@@ -0,0 +1,127 @@
+#ifndef VSL_TCP_TCP_BYTE_ORDER_H
+#define VSL_TCP_TCP_BYTE_ORDER_H
+
+#include <vsl/concepts.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace vsl::tcp::detail
+{
+
+template<size_t Size>
+inline constexpr auto has_uint_of_size = (Size == 2 || Size == 4 || Size == 8);
+
+template<size_t Size>
+using uint_of_size = std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>;
+
+// Shift form, recognized by compilers as a bswap instruction
+template<std::unsigned_integral T>
+constexpr auto byteswap_uint(T value) noexcept -> T
+{
+    if constexpr (sizeof(T) == 2)
+    {
+        return static_cast<T>((value << 8) | (value >> 8));
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return ((value & 0x000000FFU) << 24) | ((value & 0x0000FF00U) << 8) | ((value & 0x00FF0000U) >> 8)
+               | ((value & 0xFF000000U) >> 24);
+    }
+    else
+    {
+        static_assert(sizeof(T) == 8);
+        return (static_cast<T>(byteswap_uint(static_cast<uint32_t>(value))) << 32)
+               | byteswap_uint(static_cast<uint32_t>(value >> 32));
+    }
+}
+
+template<vsl::numeric T>
+constexpr auto byteswap(T value) noexcept -> T
+{
+    if constexpr (sizeof(T) == 1)
+    {
+        return value;
+    }
+    else if constexpr (has_uint_of_size<sizeof(T)>)
+    {
+        return std::bit_cast<T>(byteswap_uint(std::bit_cast<uint_of_size<sizeof(T)>>(value)));
+    }
+    else
+    {
+        auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+        std::ranges::reverse(bytes);
+        return std::bit_cast<T>(bytes);
+    }
+}
+
+template<vsl::numeric T>
+auto load(const void* data, std::endian order) noexcept -> T
+{
+    auto value = T{};
+    std::memcpy(&value, data, sizeof(T));
+    return (order == std::endian::native) ? value : byteswap(value);
+}
+
+template<vsl::numeric T>
+auto store(void* data, T value, std::endian order) noexcept -> void
+{
+    if (order != std::endian::native) value = byteswap(value);
+    std::memcpy(data, &value, sizeof(T));
+}
+
+// Swaps the bytes of every item in place. Items are processed in 32-byte blocks
+// that compilers turn into SIMD shuffles (pshufb), the tail is swapped item by item.
+template<size_t ItemSize>
+auto byteswap_items(std::byte* data, size_t size) noexcept -> void
+{
+    if constexpr (ItemSize > 1 && !has_uint_of_size<ItemSize>)
+    {
+        for (auto offset = size_t{0}; offset + ItemSize <= size; offset += ItemSize)
+        {
+            std::reverse(data + offset, data + offset + ItemSize);
+        }
+    }
+    else if constexpr (ItemSize > 1)
+    {
+        using uint_type = uint_of_size<ItemSize>;
+        constexpr auto BLOCK_ITEM_COUNT = size_t{32} / ItemSize;
+
+        auto offset = size_t{0};
+        for (; offset + BLOCK_ITEM_COUNT * ItemSize <= size; offset += BLOCK_ITEM_COUNT * ItemSize)
+        {
+            auto block = std::array<uint_type, BLOCK_ITEM_COUNT>{};
+            std::memcpy(block.data(), data + offset, sizeof(block));
+            for (auto& item : block)
+            {
+                item = byteswap_uint(item);
+            }
+            std::memcpy(data + offset, block.data(), sizeof(block));
+        }
+
+        for (; offset + ItemSize <= size; offset += ItemSize)
+        {
+            auto item = uint_type{};
+            std::memcpy(&item, data + offset, ItemSize);
+            item = byteswap_uint(item);
+            std::memcpy(data + offset, &item, ItemSize);
+        }
+    }
+}
+
+template<vsl::numeric T, size_t Extent>
+auto byteswap_items(std::span<T, Extent> items) noexcept -> void
+{
+    byteswap_items<sizeof(T)>(reinterpret_cast<std::byte*>(items.data()), items.size_bytes());
+}
+
+}  // namespace vsl::tcp::detail
+
+#endif  // VSL_TCP_TCP_BYTE_ORDER_H
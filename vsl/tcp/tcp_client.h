@@ -3,6 +3,8 @@
 
 #include <vsl/concepts.h>
 #include <vsl/tcp/tcp_buffer.h>
+#include <vsl/tcp/tcp_metrics.h>
+#include <vsl/tcp/tcp_struct.h>
 
 #include <fmt/format.h>
 #include <Poco/BinaryReader.h>
@@ -11,10 +13,16 @@
 #include <Poco/Net/SocketStream.h>
 #include <Poco/Net/StreamSocket.h>
 
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -59,6 +67,14 @@ class TcpClientConnectionReset : public TcpClientDisconnect
     {}
 };
 
+class TcpTimeout : public TcpClientError
+{
+  public:
+    TcpTimeout()
+        : TcpClientError{"Operation timed out"}
+    {}
+};
+
 class TcpClient final
 {
   public:
@@ -77,6 +93,26 @@ class TcpClient final
         LE = 3,
     };
 
+    enum class BufferMode
+    {
+        COPY,
+        GATHER,
+    };
+
+    // UNIX: AF_UNIX stream sockets, the endpoints are socket file paths
+    enum class Transport
+    {
+        TCP,
+        UNIX,
+    };
+
+    enum class FlushPolicy
+    {
+        IMMEDIATE,
+        CORKED,
+        COALESCE,
+    };
+
     struct size64_t
     {
         using type = uint64_t;
@@ -87,22 +123,52 @@ class TcpClient final
         using type = uint32_t;
     };
 
-    TcpClient(ByteOrder byte_order = ByteOrder::NATIVE);
+    using Clock = std::chrono::steady_clock;
+    using Deadline = Clock::time_point;
+    using WritableHandler = std::function<void()>;
+
+    TcpClient(ByteOrder byte_order = ByteOrder::NATIVE, Transport transport = Transport::TCP);
+
+    // Move-only: the buffers and the flush state are per object, copies would diverge on the same socket
+    TcpClient(TcpClient&&) = default;
+    TcpClient& operator=(TcpClient&&) = default;
+
+    TcpClient(const TcpClient&) = delete;
+    TcpClient& operator=(const TcpClient&) = delete;
+
+    ~TcpClient() = default;
+
+    // Connected pair of UNIX transport clients (socketpair), e.g. for a child process or a thread (Linux only)
+    static auto make_pair(ByteOrder byte_order = ByteOrder::NATIVE) -> std::pair<TcpClient, TcpClient>;
 
     auto connect(const std::pair<std::string, int>& endpoint) -> void;
     auto connect(const std::string& host, int port) -> void;
+    // "host:port" or the socket file path for the UNIX transport
     auto connect(const std::string& endpoint) -> void;
 
+    // Throw TcpTimeout if the connection is not established within the timeout
+    auto connect(const std::pair<std::string, int>& endpoint, std::chrono::milliseconds timeout) -> void;
+    auto connect(const std::string& host, int port, std::chrono::milliseconds timeout) -> void;
+
     auto shutdown(ShutdownType how = ShutdownType::BOTH) -> void;
     auto close() -> void;
 
     auto enable_buffer(bool state) -> void;
+
+    // GATHER: buffered writes of 256+ bytes are referenced instead of copied and sent with one
+    // vectored send by write_buffer(), so their data must stay valid until then.
+    // Can be switched only while the buffer is empty.
+    auto set_buffer_mode(BufferMode mode) -> void;
     auto buffer_size() const -> int;
     auto buffer_empty() const -> bool;
     auto buffer_capacity() const -> int;
     auto reserve_buffer(int capacity) -> void;
     auto shrink_buffer_to_fit() -> void;
 
+    // Reads from the socket into an own receive buffer bypassing the Poco streams.
+    // Can be switched only while there is no unread data.
+    auto enable_direct_receive(bool state) -> void;
+
     template<typename T>
         requires vsl::numeric<T>
     auto read() -> T;
@@ -111,14 +177,38 @@ class TcpClient final
         requires vsl::numeric<T>
     auto write(T value) -> void;
 
+    // Deadline reads throw TcpTimeout, a timed out read may leave a value partially read
+    template<typename T>
+        requires vsl::numeric<T>
+    auto read(Deadline deadline) -> T;
+
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto read_string(Deadline deadline) -> std::string;
+
+    template<typename T, typename Size>
+    auto read_raw(T* buffer, Size length, Deadline deadline) -> void;
+
     template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t>
         requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
     auto read_vector() -> std::vector<ItemType>;
 
+    // Reads into the caller's storage and returns the item count, throws if the vector does not fit
+    template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t, size_t Extent = std::dynamic_extent>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto read_vector(std::span<ItemType, Extent> vec) -> size_t;
+
     template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t>
         requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
     auto write_vector(const std::vector<ItemType>& vec) -> void;
 
+    // Items without a size prefix, converted to the byte order unlike read_raw/write_raw
+    template<vsl::numeric ItemType, size_t Extent>
+    auto read_items(std::span<ItemType, Extent> items) -> void;
+
+    template<vsl::numeric ItemType, size_t Extent>
+    auto write_items(std::span<ItemType, Extent> items) -> void;
+
     template<typename SizeType = TcpClient::size64_t>
         requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
     auto read_string() -> std::string;
@@ -127,6 +217,23 @@ class TcpClient final
         requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
     auto write_string(std::string_view str) -> void;
 
+    // Structs declared with VSL_TCP_STRUCT, strings and vectors are size prefixed (size64_t).
+    // Reading reuses the storage of the strings and vectors of the object.
+    template<vsl::tcp::tcp_struct T>
+    auto read_struct(T& obj) -> void;
+
+    template<vsl::tcp::tcp_struct T>
+    auto write_struct(const T& obj) -> void;
+
+    // Reads a size prefixed frame (as written by write_string/write_vector) without copying it.
+    // The span is valid until the next read.
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto read_frame() -> std::span<const std::byte>;
+
+    // Reads size bytes without copying them, the span is valid until the next read
+    auto read_span(size_t size) -> std::span<const std::byte>;
+
     template<typename T, typename Size>
     auto read_raw(T* buffer, Size length) -> void;
 
@@ -135,9 +242,48 @@ class TcpClient final
 
     auto write_buffer() -> void;
 
+    // Non-blocking writes for slow peers: the data the socket does not take at once is queued and sent
+    // by send_pending(). A write is taken as a whole, but is refused (returns 0) while the queued size is above
+    // the high watermark, so the caller may drop or delay the data. Once send_pending() gets the queued size
+    // down to the low watermark, the writable handler is called. The stream writes must be flushed before,
+    // queued data is discarded by close().
+    template<typename T, typename Size>
+    auto try_write_raw(const T* buffer, Size length) -> size_t;
+
+    // Returns true if no data is left queued
+    auto send_pending() -> bool;
+
+    // Waits until the socket can take more data (then send_pending() makes progress), throws TcpTimeout
+    auto wait_writable(Deadline deadline) -> void;
+    auto pending_write_size() const -> size_t;
+    auto is_writable() const -> bool;
+    auto set_write_watermarks(size_t low_watermark, size_t high_watermark) -> void;
+    auto on_writable(WritableHandler handler) -> void;
+
     auto flush() -> void;
 
+    // Throws TcpTimeout if the socket does not take the written data before the deadline (e.g. the peer does not
+    // read). A timed out flush may leave the data partly sent and the write stream failed, so the connection has to
+    // be closed. The deadline is applied as SO_SNDTIMEO set to the time left when the flush starts.
+    auto flush(Deadline deadline) -> void;
+
+    // IMMEDIATE: flush() sends the data at once (TCP_NODELAY).
+    // CORKED: only full segments are sent between the flushes (TCP_CORK), flush() sends the rest.
+    // COALESCE: as CORKED, but flush() sends the rest only if coalesce_size bytes were written or
+    // coalesce_delay passed since the last send, so a single message after a pause is sent at once,
+    // while the messages of a burst share segments. The held data is sent by the next flush or read (the peer may
+    // wait for it to reply), by poll_flush() or, at worst, by the kernel within 200 ms.
+    // CORKED and COALESCE use TCP_CORK on Linux and fall back to Nagle's algorithm on other systems.
+    auto set_flush_policy(FlushPolicy policy) -> void;
+    auto get_flush_policy() const -> FlushPolicy;
+    auto set_coalesce_threshold(size_t coalesce_size, std::chrono::microseconds coalesce_delay) -> void;
+
+    // COALESCE: sends the held data once coalesce_delay has passed since the last send. Returns when to call it
+    // again (e.g. as a timer or poll timeout of an event loop), nullopt if no data is held.
+    auto poll_flush() -> std::optional<Deadline>;
+
     auto wait_for_disconnect() -> void;
+    auto wait_for_disconnect(Deadline deadline) -> void;
     auto data_available() -> int;
     auto is_active() const -> bool;
 
@@ -150,19 +296,64 @@ class TcpClient final
     auto get_send_buffer_size() const -> int;
     auto set_send_buffer_size(int size) -> void;
 
+    // The UNIX transport endpoints are the socket file paths with port 0
     auto get_local_endpoint() const -> std::pair<std::string, int>;
     auto get_remote_endpoint() const -> std::pair<std::string, int>;
+    auto get_transport() const -> Transport;
+
+    // Opt-in, the metrics may be shared with other clients (nullptr disables them)
+    auto set_metrics(std::shared_ptr<TcpMetrics> metrics) -> void;
+    auto get_metrics() const -> const std::shared_ptr<TcpMetrics>&;
 
   private:
     friend class TcpListener;
+    friend class TcpSender;
+
+    static inline constexpr auto RECEIVE_CHUNK_SIZE = size_t{16 * 1024};
+    static inline constexpr auto MAX_GATHER_PIECES = size_t{1024};
+    static inline constexpr auto CONVERSION_CHUNK_SIZE = size_t{4096};
+    static inline constexpr auto DEFAULT_COALESCE_SIZE = size_t{4096};
+    static inline constexpr auto DEFAULT_COALESCE_DELAY = std::chrono::microseconds{1000};
+    static inline constexpr auto DEFAULT_LOW_WATERMARK = size_t{64 * 1024};
+    static inline constexpr auto DEFAULT_HIGH_WATERMARK = size_t{1024 * 1024};
 
-    explicit TcpClient(Poco::Net::StreamSocket socket, ByteOrder byte_order);
+    // The socket options are left as is: TcpListener applies them once per accepted socket
+    explicit TcpClient(Poco::Net::StreamSocket socket, ByteOrder byte_order, Transport transport);
 
-    auto connect(Poco::Net::SocketAddress socket_addr) -> void;
+    auto connect(Poco::Net::SocketAddress socket_addr, std::optional<std::chrono::milliseconds> timeout) -> void;
     auto throw_connect_error(std::string_view error_desc) -> void;
+    auto check_tcp_transport() -> void;
     auto get_active_binary_writer() -> Poco::BinaryWriter&;
+
+    auto metrics_timer(LatencyHistogram TcpMetrics::*histogram) const -> detail::LatencyTimer;
+    auto socket_write_timer() const -> detail::LatencyTimer;
+    auto add_metric(std::atomic<uint64_t> TcpMetrics::*counter, uint64_t value) const -> void;
     auto check_connection() -> void;
 
+    auto flush_writer() -> void;
+    auto apply_flush_policy(bool is_new_socket) -> void;
+    auto push_segments() -> void;
+    auto push_coalesced() -> void;
+    auto count_sent(size_t size) -> void;
+    auto send_nonblocking(const std::byte* data, size_t size) -> size_t;
+
+    template<typename T>
+    auto read_field(T& value) -> void;
+
+    template<typename T>
+    auto write_field(const T& value) -> void;
+
+    auto send_gathered(GatherBuffer& buffer) -> void;
+    auto is_gathering() const -> bool;
+
+    auto wait_readable(Deadline deadline) -> void;
+    auto wait_socket(Deadline deadline, int mode) -> void;
+    auto receive_some(std::byte* data, size_t size, std::optional<Deadline> deadline = std::nullopt) -> size_t;
+    auto ensure_received(size_t size, std::optional<Deadline> deadline = std::nullopt) -> void;
+    auto receive_direct(std::byte* data, size_t size, std::optional<Deadline> deadline = std::nullopt) -> void;
+    auto receive_stream(std::byte* data, size_t size, Deadline deadline) -> void;
+    auto read_stream(std::byte* data, size_t size) -> void;
+
     template<typename T>
         requires vsl::one_of_type<T, Poco::BinaryReader, Poco::BinaryWriter>
     auto check_stream_status(T& stream) const -> void;
@@ -177,6 +368,29 @@ class TcpClient final
     std::shared_ptr<Poco::BinaryWriter> buffer_binary_writer_;
 
     bool buffer_ebabled_{false};
+
+    BufferMode buffer_mode_{BufferMode::COPY};
+    GatherBuffer gather_buffer_{};
+
+    std::endian byte_order_;
+    Transport transport_;
+    ReceiveBuffer receive_buffer_{};
+    bool direct_receive_enabled_{false};
+
+    std::shared_ptr<TcpMetrics> metrics_{};
+
+    FlushPolicy flush_policy_{FlushPolicy::IMMEDIATE};
+    size_t coalesce_size_{DEFAULT_COALESCE_SIZE};
+    std::chrono::microseconds coalesce_delay_{DEFAULT_COALESCE_DELAY};
+    size_t unpushed_size_{0};
+    Clock::time_point last_push_time_{};
+    bool coalesce_pending_{false};
+
+    ReceiveBuffer outbound_buffer_{};
+    size_t low_watermark_{DEFAULT_LOW_WATERMARK};
+    size_t high_watermark_{DEFAULT_HIGH_WATERMARK};
+    bool write_blocked_{false};
+    WritableHandler writable_handler_{};
 };
 
 }  // namespace vsl::tcp
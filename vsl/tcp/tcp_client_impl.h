@@ -1,7 +1,10 @@
 #ifndef VSL_TCP_TCP_CLIENT_IMPL_H
 #define VSL_TCP_TCP_CLIENT_IMPL_H
 
+#include "tcp_byte_order.h"
+
 #include <vsl/concepts.h>
+#include <vsl/os.h>
 #include <vsl/scope_guard.h>
 #include <vsl/types.h>
 
@@ -9,25 +12,106 @@
 #include <Poco/BinaryWriter.h>
 #include <Poco/Exception.h>
 #include <Poco/Net/NetException.h>
+#include <Poco/Net/Socket.h>
 #include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/SocketDefs.h>
 #include <Poco/Net/SocketStream.h>
 #include <Poco/Net/StreamSocket.h>
+#include <Poco/Net/StreamSocketImpl.h>
+#include <Poco/Timespan.h>
+
+#if defined(VSL_LINUX_OS)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <ios>
 #include <limits>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <utility>
 
 namespace vsl::tcp
 {
 
-inline TcpClient::TcpClient(ByteOrder byte_order)
-    : TcpClient{Poco::Net::StreamSocket{}, byte_order}
+namespace detail
+{
+
+inline constexpr auto to_endian(TcpClient::ByteOrder byte_order) noexcept -> std::endian
+{
+    switch (byte_order)
+    {
+    case TcpClient::ByteOrder::BE:
+        return std::endian::big;
+    case TcpClient::ByteOrder::LE:
+        return std::endian::little;
+    case TcpClient::ByteOrder::NATIVE:
+        break;
+    }
+    return std::endian::native;
+}
+
+[[noreturn]] inline auto throw_system_error(std::string_view error_message, int error_code = errno) -> void
+{
+    throw TcpError{error_message, std::generic_category().message(error_code)};
+}
+
+// Maps errno of a failed socket send/receive to the TcpClient error types
+[[noreturn]] inline auto throw_client_error(int error_code = errno) -> void
+{
+    if (error_code == ECONNRESET || error_code == EPIPE)
+    {
+        throw TcpClientConnectionReset{};
+    }
+    throw TcpClientError{"Socket error", std::generic_category().message(error_code)};
+}
+
+#if defined(VSL_LINUX_OS)
+// Takes the ownership of an accepted fd, it is closed if wrapping throws
+inline auto wrap_socket_fd(int fd) -> Poco::Net::StreamSocket
+{
+    auto is_owned = false;
+    VSL_SCOPE_GUARD
+    {
+        if (!is_owned) ::close(fd);
+    };
+
+    auto socket = Poco::Net::StreamSocket{new Poco::Net::StreamSocketImpl{fd}};
+    is_owned = true;
+    return socket;
+}
+#endif
+
+inline auto to_endpoint(const Poco::Net::SocketAddress& socket_addr) -> std::pair<std::string, int>
+{
+    if (socket_addr.family() == Poco::Net::SocketAddress::UNIX_LOCAL)
+    {
+        return std::pair{socket_addr.toString(), 0};
+    }
+    return std::pair{socket_addr.host().toString(), int{socket_addr.port()}};
+}
+
+}  // namespace detail
+
+inline TcpClient::TcpClient(ByteOrder byte_order, Transport transport)
+    : TcpClient{Poco::Net::StreamSocket{}, byte_order, transport}
 {}
 
-inline TcpClient::TcpClient(Poco::Net::StreamSocket socket, ByteOrder byte_order)
+inline TcpClient::TcpClient(Poco::Net::StreamSocket socket, ByteOrder byte_order, Transport transport)
     : socket_{std::move(socket)},
       socket_stream_{std::make_shared<Poco::Net::SocketStream>(socket_)},
       binary_reader_{
@@ -43,12 +127,40 @@ inline TcpClient::TcpClient(Poco::Net::StreamSocket socket, ByteOrder byte_order
       buffer_binary_writer_{
           std::make_shared<Poco::BinaryWriter>(*buffer_stream_,                                               //
                                                static_cast<Poco::BinaryWriter::StreamByteOrder>(byte_order))  //
-      }
+      },
+      byte_order_{detail::to_endian(byte_order)},
+      transport_{transport}
+{}
+
+inline auto TcpClient::make_pair(ByteOrder byte_order) -> std::pair<TcpClient, TcpClient>
 {
-    if (socket_.impl()->initialized())
+#if defined(VSL_LINUX_OS)
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0)
     {
-        socket_.setNoDelay(true);
+        detail::throw_system_error("Failed to create socket pair");
     }
+
+    // The fds not yet owned by a socket are closed if wrapping throws
+    auto owned_count = 0;
+    VSL_SCOPE_GUARD
+    {
+        for (auto i = owned_count; i < 2; ++i)
+        {
+            ::close(fds[i]);
+        }
+    };
+
+    auto first = Poco::Net::StreamSocket{new Poco::Net::StreamSocketImpl{fds[0]}};
+    owned_count = 1;
+    auto second = Poco::Net::StreamSocket{new Poco::Net::StreamSocketImpl{fds[1]}};
+    owned_count = 2;
+
+    return std::pair{TcpClient{std::move(first), byte_order, Transport::UNIX},
+                     TcpClient{std::move(second), byte_order, Transport::UNIX}};
+#else
+    throw TcpClientError{"Failed to create socket pair", "Not supported"};
+#endif
 }
 
 inline auto TcpClient::connect(const std::pair<std::string, int>& endpoint) -> void
@@ -58,10 +170,12 @@ inline auto TcpClient::connect(const std::pair<std::string, int>& endpoint) -> v
 
 inline auto TcpClient::connect(const std::string& host, int port) -> void
 {
+    check_tcp_transport();
+
     try
     {
         const auto socket_addr = Poco::Net::SocketAddress{host, vsl::checked_cast<uint16_t>(port)};
-        connect(socket_addr);
+        connect(socket_addr, std::nullopt);
     }
     catch (const Poco::Exception& ex)
     {
@@ -73,8 +187,34 @@ inline auto TcpClient::connect(const std::string& endpoint) -> void
 {
     try
     {
-        const auto socket_addr = Poco::Net::SocketAddress{endpoint};
-        connect(socket_addr);
+        const auto socket_addr = (transport_ == Transport::UNIX)
+                                     ? Poco::Net::SocketAddress{Poco::Net::SocketAddress::UNIX_LOCAL, endpoint}
+                                     : Poco::Net::SocketAddress{endpoint};
+        connect(socket_addr, std::nullopt);
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw_connect_error(ex.displayText());
+    }
+}
+
+inline auto TcpClient::connect(const std::pair<std::string, int>& endpoint, std::chrono::milliseconds timeout) -> void
+{
+    connect(endpoint.first, endpoint.second, timeout);
+}
+
+inline auto TcpClient::connect(const std::string& host, int port, std::chrono::milliseconds timeout) -> void
+{
+    check_tcp_transport();
+
+    try
+    {
+        const auto socket_addr = Poco::Net::SocketAddress{host, vsl::checked_cast<uint16_t>(port)};
+        connect(socket_addr, timeout);
+    }
+    catch (const Poco::TimeoutException&)
+    {
+        throw TcpTimeout{};
     }
     catch (const Poco::Exception& ex)
     {
@@ -82,10 +222,20 @@ inline auto TcpClient::connect(const std::string& endpoint) -> void
     }
 }
 
-inline auto TcpClient::connect(Poco::Net::SocketAddress socket_addr) -> void
+// Poco polls the connecting socket if there is a timeout
+inline auto TcpClient::connect(Poco::Net::SocketAddress socket_addr, std::optional<std::chrono::milliseconds> timeout)
+    -> void
 {
-    socket_.connect(socket_addr);
-    socket_.setNoDelay(true);
+    if (timeout)
+    {
+        auto timespan = Poco::Timespan{vsl::checked_cast<Poco::Timespan::TimeDiff>(timeout->count()) * 1000};
+        socket_.connect(socket_addr, timespan);
+    }
+    else
+    {
+        socket_.connect(socket_addr);
+    }
+    apply_flush_policy(true);
 }
 
 inline auto TcpClient::throw_connect_error(std::string_view error_desc) -> void
@@ -93,6 +243,14 @@ inline auto TcpClient::throw_connect_error(std::string_view error_desc) -> void
     throw TcpClientError{"Connection failed", error_desc};
 }
 
+inline auto TcpClient::check_tcp_transport() -> void
+{
+    if (transport_ != Transport::TCP)
+    {
+        throw_connect_error("Host and port are used by the TCP transport only");
+    }
+}
+
 inline auto TcpClient::shutdown(ShutdownType how) -> void
 {
     try
@@ -133,14 +291,31 @@ inline auto TcpClient::enable_buffer(bool state) -> void
     buffer_ebabled_ = state;
 }
 
+inline auto TcpClient::set_buffer_mode(BufferMode mode) -> void
+{
+    if (mode == buffer_mode_) return;
+
+    if (!buffer_empty())
+    {
+        throw TcpClientError{"Failed to switch buffer mode", "Buffer is not empty"};
+    }
+
+    buffer_mode_ = mode;
+}
+
+inline auto TcpClient::is_gathering() const -> bool
+{
+    return buffer_ebabled_ && buffer_mode_ == BufferMode::GATHER;
+}
+
 inline auto TcpClient::buffer_size() const -> int
 {
-    return vsl::checked_cast<int>(buffer_streambuf_->buffer_size());
+    return vsl::checked_cast<int>(buffer_streambuf_->buffer_size() + gather_buffer_.size());
 }
 
 inline auto TcpClient::buffer_empty() const -> bool
 {
-    return buffer_streambuf_->buffer_empty();
+    return buffer_streambuf_->buffer_empty() && gather_buffer_.empty();
 }
 
 inline auto TcpClient::buffer_capacity() const -> int
@@ -158,29 +333,166 @@ inline auto TcpClient::shrink_buffer_to_fit() -> void
     buffer_streambuf_->shrink_buffer_to_fit();
 }
 
+inline auto TcpClient::enable_direct_receive(bool state) -> void
+{
+    if (state == direct_receive_enabled_) return;
+
+    auto has_unread_data = state ? (binary_reader_->available() > 0) : !receive_buffer_.empty();
+    if (has_unread_data)
+    {
+        throw TcpClientError{"Failed to switch receive mode", "Receive buffer is not empty"};
+    }
+
+    direct_receive_enabled_ = state;
+}
+
 inline auto TcpClient::get_active_binary_writer() -> Poco::BinaryWriter&
 {
     return buffer_ebabled_ ? *buffer_binary_writer_ : *binary_writer_;
 }
 
+inline auto TcpClient::set_metrics(std::shared_ptr<TcpMetrics> metrics) -> void
+{
+    metrics_ = std::move(metrics);
+}
+
+inline auto TcpClient::get_metrics() const -> const std::shared_ptr<TcpMetrics>&
+{
+    return metrics_;
+}
+
+inline auto TcpClient::metrics_timer(LatencyHistogram TcpMetrics::*histogram) const -> detail::LatencyTimer
+{
+    return detail::LatencyTimer{metrics_ ? &(*metrics_.*histogram) : nullptr};
+}
+
+// Writes into the own buffer are timed and counted by write_buffer()
+inline auto TcpClient::socket_write_timer() const -> detail::LatencyTimer
+{
+    return detail::LatencyTimer{(metrics_ && !buffer_ebabled_) ? &metrics_->write_latency : nullptr};
+}
+
+inline auto TcpClient::add_metric(std::atomic<uint64_t> TcpMetrics::*counter, uint64_t value) const -> void
+{
+    if (metrics_) (*metrics_.*counter).fetch_add(value, std::memory_order_relaxed);
+}
+
 template<typename T>
     requires vsl::numeric<T>
 auto TcpClient::read() -> T
 {
-    T value;
-    *binary_reader_ >> value;
-    check_stream_status(*binary_reader_);
-    return value;
+    push_coalesced();
+
+    if (direct_receive_enabled_)
+    {
+        ensure_received(sizeof(T));
+        auto value = T{};
+        if constexpr (std::same_as<T, bool>)
+        {
+            value = detail::load<uint8_t>(receive_buffer_.data(), byte_order_) != 0;
+        }
+        else
+        {
+            value = detail::load<T>(receive_buffer_.data(), byte_order_);
+        }
+        receive_buffer_.consume(sizeof(T));
+        return value;
+    }
+
+    auto bytes = std::array<std::byte, sizeof(T)>{};
+    read_stream(bytes.data(), bytes.size());
+    if constexpr (std::same_as<T, bool>)
+    {
+        return detail::load<uint8_t>(bytes.data(), byte_order_) != 0;
+    }
+    else
+    {
+        return detail::load<T>(bytes.data(), byte_order_);
+    }
 }
 
 template<typename T>
     requires vsl::numeric<T>
 auto TcpClient::write(T value) -> void
 {
+    if (is_gathering())
+    {
+        auto bytes = std::array<std::byte, sizeof(T)>{};
+        detail::store(bytes.data(), value, byte_order_);
+        gather_buffer_.append(bytes.data(), bytes.size());
+        return;
+    }
+
     auto& active_writer = get_active_binary_writer();
+    auto timer = socket_write_timer();
 
     active_writer << value;
     check_stream_status(active_writer);
+
+    if (!buffer_ebabled_) count_sent(sizeof(T));
+}
+
+template<typename T>
+    requires vsl::numeric<T>
+auto TcpClient::read(Deadline deadline) -> T
+{
+    push_coalesced();
+
+    if (direct_receive_enabled_)
+    {
+        ensure_received(sizeof(T), deadline);
+        auto value = T{};
+        if constexpr (std::same_as<T, bool>)
+        {
+            value = detail::load<uint8_t>(receive_buffer_.data(), byte_order_) != 0;
+        }
+        else
+        {
+            value = detail::load<T>(receive_buffer_.data(), byte_order_);
+        }
+        receive_buffer_.consume(sizeof(T));
+        return value;
+    }
+
+    auto bytes = std::array<std::byte, sizeof(T)>{};
+    receive_stream(bytes.data(), bytes.size(), deadline);
+    if constexpr (std::same_as<T, bool>)
+    {
+        return detail::load<uint8_t>(bytes.data(), byte_order_) != 0;
+    }
+    else
+    {
+        return detail::load<T>(bytes.data(), byte_order_);
+    }
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto TcpClient::read_string(Deadline deadline) -> std::string
+{
+    auto size = read<typename SizeType::type>(deadline);
+    auto str = std::string{};
+    str.resize(size);
+
+    read_raw(str.data(), str.size(), deadline);
+
+    return str;
+}
+
+template<typename T, typename Size>
+auto TcpClient::read_raw(T* buffer, Size length, Deadline deadline) -> void
+{
+    push_coalesced();
+
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+
+    if (direct_receive_enabled_)
+    {
+        receive_direct(reinterpret_cast<std::byte*>(buffer), data_size, deadline);
+        return;
+    }
+
+    receive_stream(reinterpret_cast<std::byte*>(buffer), data_size, deadline);
 }
 
 template<vsl::numeric ItemType, typename SizeType>
@@ -191,18 +503,73 @@ auto TcpClient::read_vector() -> std::vector<ItemType>
     auto vec = std::vector<ItemType>{};
     vec.resize(size);
 
-    read_raw(vec.data(), vec.size());
+    read_items(std::span{vec});
 
     return vec;
 }
 
+template<vsl::numeric ItemType, typename SizeType, size_t Extent>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto TcpClient::read_vector(std::span<ItemType, Extent> vec) -> size_t
+{
+    auto size = vsl::checked_cast<size_t>(read<typename SizeType::type>());
+    if (size > vec.size())
+    {
+        throw TcpClientError{"Failed to read vector", fmt::format("{} items do not fit into {}", size, vec.size())};
+    }
+
+    read_items(vec.first(size));
+
+    return size;
+}
+
 template<vsl::numeric ItemType, typename SizeType>
     requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
 auto TcpClient::write_vector(const std::vector<ItemType>& vec) -> void
 {
     auto size = vsl::checked_cast<typename SizeType::type>(vec.size());
     write(size);
-    write_raw(vec.data(), vec.size());
+    write_items(std::span{vec});
+}
+
+template<vsl::numeric ItemType, size_t Extent>
+auto TcpClient::read_items(std::span<ItemType, Extent> items) -> void
+{
+    read_raw(items.data(), items.size());
+    if (byte_order_ != std::endian::native) detail::byteswap_items(items);
+}
+
+// Non-native items are converted chunk by chunk
+template<vsl::numeric ItemType, size_t Extent>
+auto TcpClient::write_items(std::span<ItemType, Extent> items) -> void
+{
+    if (byte_order_ == std::endian::native)
+    {
+        write_raw(items.data(), items.size());
+        return;
+    }
+
+    using item_type = std::remove_const_t<ItemType>;
+    auto chunk = std::array<item_type, std::max(CONVERSION_CHUNK_SIZE / sizeof(item_type), size_t{1})>{};
+
+    for (auto offset = size_t{0}; offset < items.size();)
+    {
+        auto count = std::min(items.size() - offset, chunk.size());
+        auto converted = std::span{chunk}.first(count);
+        std::ranges::copy(items.subspan(offset, count), converted.begin());
+        detail::byteswap_items(converted);
+
+        if (is_gathering())
+        {
+            gather_buffer_.append_copy(reinterpret_cast<const std::byte*>(converted.data()), converted.size_bytes());
+        }
+        else
+        {
+            write_raw(converted.data(), converted.size());
+        }
+
+        offset += count;
+    }
 }
 
 template<typename SizeType>
@@ -227,111 +594,821 @@ auto TcpClient::write_string(std::string_view str) -> void
     write_raw(str.data(), str.size());
 }
 
-template<typename T, typename Size>
-auto TcpClient::read_raw(T* buffer, Size length) -> void
-{
-    auto data_ptr = reinterpret_cast<char*>(buffer);
-    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
-    binary_reader_->readRaw(data_ptr, static_cast<std::streamsize>(data_size));
-
-    check_stream_status(*binary_reader_);
-}
-
-template<typename T, typename Size>
-auto TcpClient::write_raw(const T* buffer, Size length) -> void
+template<vsl::tcp::tcp_struct T>
+auto TcpClient::read_struct(T& obj) -> void
 {
-    auto& active_writer = get_active_binary_writer();
-
-    auto data_ptr = reinterpret_cast<const char*>(buffer);
-    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
-    active_writer.writeRaw(data_ptr, static_cast<std::streamsize>(data_size));
-
-    check_stream_status(active_writer);
+    read_field(obj);
 }
 
-inline auto TcpClient::write_buffer() -> void
+template<vsl::tcp::tcp_struct T>
+auto TcpClient::write_struct(const T& obj) -> void
 {
-    buffer_binary_writer_->flush();
-
-    auto span = buffer_streambuf_->get_span();
-    write_raw(span.data(), span.size());
-
-    buffer_streambuf_->clear_buffer();
+    write_field(obj);
 }
 
-inline auto TcpClient::flush() -> void
+template<typename T>
+auto TcpClient::read_field(T& value) -> void
 {
-    try
+    if constexpr (std::same_as<T, bool>)
     {
-        binary_writer_->flush();
+        value = read<uint8_t>() != 0;
     }
-    catch (const Poco::Net::NetException&)
+    else if constexpr (vsl::numeric<T>)
     {
-        throw TcpClientConnectionReset{};
+        value = read<T>();
     }
-
-    check_stream_status(*binary_writer_);
-}
-
-inline auto TcpClient::check_connection() -> void
-{
-    auto is_blocking = socket_.getBlocking();
-    VSL_SCOPE_GUARD
+    else if constexpr (std::is_enum_v<T>)
     {
-        socket_.setBlocking(is_blocking);
-    };
-    socket_.setBlocking(false);
-
-    try
+        value = static_cast<T>(read<std::underlying_type_t<T>>());
+    }
+    else if constexpr (std::same_as<T, std::string>)
     {
-        auto buffer = std::byte{};
-        auto received_count = socket_.receiveBytes(&buffer, 1, MSG_PEEK);
+        value.resize(vsl::checked_cast<size_t>(read<size64_t::type>()));
+        read_raw(value.data(), value.size());
+    }
+    else if constexpr (detail::is_std_vector<T> || detail::is_std_array<T>)
+    {
+        if constexpr (detail::is_std_vector<T>)
+        {
+            value.resize(vsl::checked_cast<size_t>(read<size64_t::type>()));
+        }
 
-        if (received_count == 0)
+        using item_type = typename T::value_type;
+        if constexpr (vsl::numeric<item_type> && !std::same_as<item_type, bool>)
         {
-            throw TcpClientGracefulShutdown{};
+            read_items(std::span{value});
+            return;
+        }
+        else if constexpr (detail::is_flat<item_type>())
+        {
+            if (byte_order_ == std::endian::native)
+            {
+                read_raw(value.data(), value.size());
+                return;
+            }
+        }
+
+        for (auto& item : value)
+        {
+            read_field(item);
         }
     }
-    catch (const Poco::Net::ConnectionResetException&)
+    else
     {
-        throw TcpClientConnectionReset{};
+        static_assert(vsl::tcp::tcp_struct<T>, "Unsupported field type");
+
+        if constexpr (detail::is_flat<T>())
+        {
+            if (byte_order_ == std::endian::native)
+            {
+                read_raw(&value, 1);
+                return;
+            }
+        }
+
+        vsl_tcp_visit_fields(value, [this](auto& field) { read_field(field); });
     }
 }
 
 template<typename T>
-    requires vsl::one_of_type<T, Poco::BinaryReader, Poco::BinaryWriter>
-auto TcpClient::check_stream_status(T& stream) const -> void
+auto TcpClient::write_field(const T& value) -> void
 {
-    if constexpr (requires { stream.eof(); })
+    if constexpr (vsl::numeric<T>)
     {
-        if (stream.eof())
-        {
-            throw TcpClientGracefulShutdown{};
-        }
+        write(value);
     }
-
-    if (stream.bad())
+    else if constexpr (std::is_enum_v<T>)
     {
-        throw TcpClientConnectionReset{};
+        write(static_cast<std::underlying_type_t<T>>(value));
     }
-
-    if (!stream.good())
+    else if constexpr (std::same_as<T, std::string>)
     {
-        throw TcpClientError{"Unknown stream error"};
+        write_string(value);
     }
-}
-
+    else if constexpr (detail::is_std_vector<T> || detail::is_std_array<T>)
+    {
+        if constexpr (detail::is_std_vector<T>)
+        {
+            write(vsl::checked_cast<size64_t::type>(value.size()));
+        }
+
+        using item_type = typename T::value_type;
+        if constexpr (vsl::numeric<item_type>)
+        {
+            write_items(std::span{value});
+            return;
+        }
+        else if constexpr (detail::is_flat<item_type>())
+        {
+            if (byte_order_ == std::endian::native)
+            {
+                write_raw(value.data(), value.size());
+                return;
+            }
+        }
+
+        for (const auto& item : value)
+        {
+            write_field(item);
+        }
+    }
+    else
+    {
+        static_assert(vsl::tcp::tcp_struct<T>, "Unsupported field type");
+
+        if constexpr (detail::is_flat<T>())
+        {
+            if (byte_order_ == std::endian::native)
+            {
+                write_raw(&value, 1);
+                return;
+            }
+        }
+
+        vsl_tcp_visit_fields(value, [this](const auto& field) { write_field(field); });
+    }
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto TcpClient::read_frame() -> std::span<const std::byte>
+{
+    auto frame = read_span(vsl::checked_cast<size_t>(read<typename SizeType::type>()));
+    add_metric(&TcpMetrics::frames_received, 1);
+    return frame;
+}
+
+inline auto TcpClient::read_span(size_t size) -> std::span<const std::byte>
+{
+    push_coalesced();
+
+    if (direct_receive_enabled_)
+    {
+        ensure_received(size);
+    }
+    else
+    {
+        auto free_space = receive_buffer_.prepare(size);
+        read_raw(free_space.data(), size);
+        receive_buffer_.commit(size);
+    }
+
+    auto data = std::span{receive_buffer_.data(), size};
+    receive_buffer_.consume(size);
+    return data;
+}
+
+template<typename T, typename Size>
+auto TcpClient::read_raw(T* buffer, Size length) -> void
+{
+    push_coalesced();
+
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+
+    if (direct_receive_enabled_)
+    {
+        receive_direct(reinterpret_cast<std::byte*>(buffer), data_size);
+        return;
+    }
+
+    read_stream(reinterpret_cast<std::byte*>(buffer), data_size);
+}
+
+template<typename T, typename Size>
+auto TcpClient::write_raw(const T* buffer, Size length) -> void
+{
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+
+    if (is_gathering())
+    {
+        gather_buffer_.append(reinterpret_cast<const std::byte*>(buffer), data_size);
+        return;
+    }
+
+    auto& active_writer = get_active_binary_writer();
+    auto timer = socket_write_timer();
+
+    auto data_ptr = reinterpret_cast<const char*>(buffer);
+    active_writer.writeRaw(data_ptr, static_cast<std::streamsize>(data_size));
+
+    check_stream_status(active_writer);
+
+    if (!buffer_ebabled_) count_sent(data_size);
+}
+
+inline auto TcpClient::write_buffer() -> void
+{
+    if (!gather_buffer_.empty())
+    {
+        send_gathered(gather_buffer_);
+        return;
+    }
+
+    buffer_binary_writer_->flush();
+
+    // Several chunks go out as one vectored send (no copy into a contiguous buffer)
+    if (buffer_streambuf_->buffer_size() > VectorStreamBuf::CHUNK_SIZE)
+    {
+        buffer_streambuf_->for_each_span([&](std::span<const char> span)
+                                         { gather_buffer_.append(std::as_bytes(span).data(), span.size()); });
+        send_gathered(gather_buffer_);
+    }
+    else
+    {
+        buffer_streambuf_->for_each_span([&](std::span<const char> span) { write_raw(span.data(), span.size()); });
+    }
+
+    buffer_streambuf_->clear_buffer();
+}
+
+template<typename T, typename Size>
+auto TcpClient::try_write_raw(const T* buffer, Size length) -> size_t
+{
+    if (write_blocked_) return 0;
+
+    auto data = reinterpret_cast<const std::byte*>(buffer);
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+
+    auto sent_count = send_pending() ? send_nonblocking(data, data_size) : size_t{0};
+
+    auto rest_size = data_size - sent_count;
+    if (rest_size > 0)
+    {
+        auto free_space = outbound_buffer_.prepare(rest_size);
+        std::memcpy(free_space.data(), data + sent_count, rest_size);
+        outbound_buffer_.commit(rest_size);
+
+        if (outbound_buffer_.size() > high_watermark_) write_blocked_ = true;
+    }
+
+    return data_size;
+}
+
+inline auto TcpClient::send_pending() -> bool
+{
+    while (!outbound_buffer_.empty())
+    {
+        auto sent_count = send_nonblocking(outbound_buffer_.data(), outbound_buffer_.size());
+        if (sent_count == 0) break;
+        outbound_buffer_.consume(sent_count);
+    }
+
+    if (write_blocked_ && outbound_buffer_.size() <= low_watermark_)
+    {
+        write_blocked_ = false;
+        if (writable_handler_) writable_handler_();
+    }
+
+    return outbound_buffer_.empty();
+}
+
+inline auto TcpClient::pending_write_size() const -> size_t
+{
+    return outbound_buffer_.size();
+}
+
+inline auto TcpClient::is_writable() const -> bool
+{
+    return !write_blocked_;
+}
+
+inline auto TcpClient::set_write_watermarks(size_t low_watermark, size_t high_watermark) -> void
+{
+    if (low_watermark > high_watermark)
+    {
+        throw TcpClientError{"Failed to set write watermarks", "Low watermark is above high watermark"};
+    }
+
+    low_watermark_ = low_watermark;
+    high_watermark_ = high_watermark;
+}
+
+inline auto TcpClient::on_writable(WritableHandler handler) -> void
+{
+    writable_handler_ = std::move(handler);
+}
+
+// Returns 0 if the socket send buffer is full
+inline auto TcpClient::send_nonblocking(const std::byte* data, size_t size) -> size_t
+{
+    auto timer = metrics_timer(&TcpMetrics::write_latency);
+
+    constexpr auto MAX_SEND_SIZE = size_t{std::numeric_limits<int>::max()};
+    size = std::min(size, MAX_SEND_SIZE);
+
+#if defined(VSL_LINUX_OS)
+    auto sent_count = ::send(socket_.impl()->sockfd(), data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    while (sent_count < 0 && errno == EINTR)
+    {
+        sent_count = ::send(socket_.impl()->sockfd(), data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+    if (sent_count < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        detail::throw_client_error();
+    }
+#else
+    // No MSG_DONTWAIT, the socket is switched to non-blocking for the send if it is blocking
+    auto sent_count = 0;
+    try
+    {
+        auto was_blocking = socket_.getBlocking();
+        if (was_blocking) socket_.setBlocking(false);
+        VSL_SCOPE_GUARD
+        {
+            if (!was_blocking) return;
+            try
+            {
+                socket_.setBlocking(true);
+            }
+            catch (const Poco::Exception&)
+            {
+            }
+        };
+        sent_count = socket_.sendBytes(data, static_cast<int>(size));
+    }
+    catch (const Poco::TimeoutException&)
+    {
+        return 0;
+    }
+    catch (const Poco::Net::ConnectionResetException&)
+    {
+        throw TcpClientConnectionReset{};
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Socket error", ex.displayText()};
+    }
+    if (sent_count < 0) return 0;
+#endif
+
+    count_sent(vsl::as_unsigned(sent_count));
+    return vsl::as_unsigned(sent_count);
+}
+
+// Data written directly before is flushed first to keep the order
+inline auto TcpClient::send_gathered(GatherBuffer& buffer) -> void
+{
+    VSL_SCOPE_GUARD
+    {
+        buffer.clear();
+    };
+
+    flush_writer();
+
+    auto buffers = Poco::Net::SocketBufVec{};
+    buffer.consume(
+        MAX_GATHER_PIECES,
+        [&](std::span<const std::span<const std::byte>> pieces)
+        {
+            buffers.clear();
+            for (auto piece : pieces)
+            {
+                buffers.push_back(Poco::Net::Socket::makeBuffer(const_cast<std::byte*>(piece.data()), piece.size()));
+            }
+
+            try
+            {
+                auto timer = metrics_timer(&TcpMetrics::write_latency);
+                auto sent_count = socket_.sendBytes(buffers);
+                if (sent_count <= 0)
+                {
+                    throw TcpClientError{"Socket error", "Failed to send data"};
+                }
+                count_sent(vsl::as_unsigned(sent_count));
+                return vsl::as_unsigned(sent_count);
+            }
+            catch (const Poco::Net::ConnectionResetException&)
+            {
+                throw TcpClientConnectionReset{};
+            }
+            catch (const Poco::Exception& ex)
+            {
+                throw TcpClientError{"Socket error", ex.displayText()};
+            }
+        });
+}
+
+inline auto TcpClient::flush() -> void
+{
+    flush_writer();
+
+    if (transport_ != Transport::TCP) return;
+
+    switch (flush_policy_)
+    {
+    case FlushPolicy::IMMEDIATE:
+        break;
+    case FlushPolicy::CORKED:
+        push_segments();
+        break;
+    case FlushPolicy::COALESCE:
+        if (unpushed_size_ >= coalesce_size_ || Clock::now() - last_push_time_ >= coalesce_delay_)
+        {
+            push_segments();
+        }
+        else
+        {
+            coalesce_pending_ = true;
+        }
+        break;
+    }
+}
+
+// The stream reports the send timeout by rethrowing the Poco exception (badbit), otherwise only a failed state is set
+inline auto TcpClient::flush(Deadline deadline) -> void
+{
+    auto timeout = std::chrono::ceil<std::chrono::microseconds>(deadline - Clock::now());
+    auto& stream = binary_writer_->stream();
+    auto exceptions = stream.exceptions();
+
+    // Setting the exception mask of a failed stream would throw
+    check_stream_status(*binary_writer_);
+
+    try
+    {
+        // Zero disables the timeout
+        socket_.setSendTimeout(Poco::Timespan{std::max(timeout.count(), std::chrono::microseconds::rep{1})});
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Failed to set send timeout", ex.displayText()};
+    }
+
+    stream.exceptions(std::ios::badbit);
+    VSL_SCOPE_GUARD
+    {
+        stream.exceptions(exceptions);
+        try
+        {
+            socket_.setSendTimeout(Poco::Timespan{0});
+        }
+        catch (const Poco::Exception&)
+        {
+        }
+    };
+
+    try
+    {
+        flush();
+    }
+    catch (const Poco::TimeoutException&)
+    {
+        throw TcpTimeout{};
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Socket error", ex.displayText()};
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw TcpClientConnectionReset{};
+    }
+}
+
+// Passes the written data to the socket without the flush policy
+inline auto TcpClient::flush_writer() -> void
+{
+    auto timer = metrics_timer(&TcpMetrics::flush_latency);
+    add_metric(&TcpMetrics::flush_count, 1);
+
+    try
+    {
+        binary_writer_->flush();
+    }
+    catch (const Poco::Net::NetException&)
+    {
+        throw TcpClientConnectionReset{};
+    }
+
+    check_stream_status(*binary_writer_);
+}
+
+inline auto TcpClient::set_flush_policy(FlushPolicy policy) -> void
+{
+    if (policy == flush_policy_) return;
+
+    flush_policy_ = policy;
+    coalesce_pending_ = false;
+
+    if (socket_.impl()->initialized())
+    {
+        apply_flush_policy(false);
+    }
+}
+
+inline auto TcpClient::get_flush_policy() const -> FlushPolicy
+{
+    return flush_policy_;
+}
+
+inline auto TcpClient::set_coalesce_threshold(size_t coalesce_size, std::chrono::microseconds coalesce_delay) -> void
+{
+    coalesce_size_ = coalesce_size;
+    coalesce_delay_ = coalesce_delay;
+}
+
+inline auto TcpClient::poll_flush() -> std::optional<Deadline>
+{
+    if (!coalesce_pending_) return std::nullopt;
+
+    auto push_time = last_push_time_ + coalesce_delay_;
+    if (Clock::now() < push_time) return push_time;
+
+    push_segments();
+    return std::nullopt;
+}
+
+// UNIX sockets send at once, the policies do not apply.
+// New sockets are not corked, so setting the cork is skipped for them (a syscall less per accepted client)
+inline auto TcpClient::apply_flush_policy(bool is_new_socket) -> void
+{
+    if (transport_ != Transport::TCP) return;
+
+    auto corked = (flush_policy_ != FlushPolicy::IMMEDIATE);
+
+    try
+    {
+#if defined(VSL_LINUX_OS)
+        socket_.setNoDelay(true);
+        if (corked || !is_new_socket) socket_.setOption(IPPROTO_TCP, TCP_CORK, corked ? 1 : 0);
+#else
+        socket_.setNoDelay(!corked);
+#endif
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Failed to set flush policy", ex.displayText()};
+    }
+}
+
+// Uncorking (or enabling TCP_NODELAY) sends the held partial segment
+inline auto TcpClient::push_segments() -> void
+{
+    try
+    {
+#if defined(VSL_LINUX_OS)
+        socket_.setOption(IPPROTO_TCP, TCP_CORK, 0);
+        socket_.setOption(IPPROTO_TCP, TCP_CORK, 1);
+#else
+        socket_.setNoDelay(true);
+        socket_.setNoDelay(false);
+#endif
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Failed to send data", ex.displayText()};
+    }
+
+    unpushed_size_ = 0;
+    last_push_time_ = Clock::now();
+    coalesce_pending_ = false;
+}
+
+// The peer may wait for the held data to reply
+inline auto TcpClient::push_coalesced() -> void
+{
+    if (coalesce_pending_) push_segments();
+}
+
+inline auto TcpClient::count_sent(size_t size) -> void
+{
+    unpushed_size_ += size;
+    add_metric(&TcpMetrics::bytes_sent, size);
+}
+
+// A readable socket without data is closed by the peer, so the peek does not block
+inline auto TcpClient::check_connection() -> void
+{
+    try
+    {
+        if (!socket_.poll(Poco::Timespan{0}, Poco::Net::Socket::SELECT_READ)) return;
+
+        auto buffer = std::byte{};
+        auto received_count = socket_.receiveBytes(&buffer, 1, MSG_PEEK);
+
+        if (received_count == 0)
+        {
+            throw TcpClientGracefulShutdown{};
+        }
+    }
+    catch (const Poco::Net::ConnectionResetException&)
+    {
+        throw TcpClientConnectionReset{};
+    }
+}
+
+inline auto TcpClient::wait_readable(Deadline deadline) -> void
+{
+    wait_socket(deadline, Poco::Net::Socket::SELECT_READ);
+}
+
+inline auto TcpClient::wait_writable(Deadline deadline) -> void
+{
+    wait_socket(deadline, Poco::Net::Socket::SELECT_WRITE);
+}
+
+// Errors end the wait too, they are reported by the next socket call
+inline auto TcpClient::wait_socket(Deadline deadline, int mode) -> void
+{
+    while (true)
+    {
+        auto timeout = std::chrono::ceil<std::chrono::microseconds>(deadline - Clock::now());
+        if (timeout.count() <= 0)
+        {
+            throw TcpTimeout{};
+        }
+
+        try
+        {
+            auto timespan = Poco::Timespan{vsl::checked_cast<Poco::Timespan::TimeDiff>(timeout.count())};
+            if (socket_.poll(timespan, mode | Poco::Net::Socket::SELECT_ERROR)) return;
+        }
+        catch (const Poco::Exception& ex)
+        {
+            throw TcpClientError{"Socket error", ex.displayText()};
+        }
+    }
+}
+
+inline auto TcpClient::receive_some(std::byte* data, size_t size, std::optional<Deadline> deadline) -> size_t
+{
+    auto timer = metrics_timer(&TcpMetrics::read_latency);
+
+    if (deadline) wait_readable(*deadline);
+
+    try
+    {
+        constexpr auto MAX_RECEIVE_SIZE = size_t{std::numeric_limits<int>::max()};
+        auto received_count = socket_.receiveBytes(data, static_cast<int>(std::min(size, MAX_RECEIVE_SIZE)));
+        if (received_count == 0)
+        {
+            throw TcpClientGracefulShutdown{};
+        }
+        add_metric(&TcpMetrics::bytes_received, vsl::as_unsigned(received_count));
+        return vsl::as_unsigned(received_count);
+    }
+    catch (const Poco::Net::ConnectionResetException&)
+    {
+        throw TcpClientConnectionReset{};
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpClientError{"Socket error", ex.displayText()};
+    }
+}
+
+// Receives until at least size unread bytes are buffered
+inline auto TcpClient::ensure_received(size_t size, std::optional<Deadline> deadline) -> void
+{
+    while (receive_buffer_.size() < size)
+    {
+        auto free_space = receive_buffer_.prepare(std::max(size - receive_buffer_.size(), RECEIVE_CHUNK_SIZE));
+        receive_buffer_.commit(receive_some(free_space.data(), free_space.size(), deadline));
+    }
+}
+
+// Large reads go directly to the destination, small ones through the receive buffer
+inline auto TcpClient::receive_direct(std::byte* data, size_t size, std::optional<Deadline> deadline) -> void
+{
+    auto taken = receive_buffer_.take(data, size);
+    data += taken;
+    size -= taken;
+
+    while (size >= RECEIVE_CHUNK_SIZE)
+    {
+        auto received_count = receive_some(data, size, deadline);
+        data += received_count;
+        size -= received_count;
+    }
+
+    if (size > 0)
+    {
+        ensure_received(size, deadline);
+        receive_buffer_.take(data, size);
+    }
+}
+
+// Stream reads are measured at the socket side: the bytes the stream buffer takes from the socket meanwhile,
+// the latency only if the read has to refill the buffer
+inline auto TcpClient::read_stream(std::byte* data, size_t size) -> void
+{
+    auto& streambuf = *binary_reader_->stream().rdbuf();
+    auto buffered = vsl::as_unsigned(std::max(streambuf.in_avail(), std::streamsize{0}));
+    auto refills = buffered < size;
+    auto timer = detail::LatencyTimer{(metrics_ && refills) ? &metrics_->read_latency : nullptr};
+
+    binary_reader_->readRaw(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+    check_stream_status(*binary_reader_);
+
+    if (refills)
+    {
+        auto left = vsl::as_unsigned(std::max(streambuf.in_avail(), std::streamsize{0}));
+        add_metric(&TcpMetrics::bytes_received, size - buffered + left);
+    }
+}
+
+// Waits only while the stream buffer is empty, then one stream read receives what the socket has
+inline auto TcpClient::receive_stream(std::byte* data, size_t size, Deadline deadline) -> void
+{
+    auto& streambuf = *binary_reader_->stream().rdbuf();
+    while (size > 0)
+    {
+        auto available = streambuf.in_avail();
+        if (available <= 0)
+        {
+            wait_readable(deadline);
+            available = 1;
+        }
+
+        auto count = std::min(size, vsl::as_unsigned(available));
+        read_stream(data, count);
+
+        data += count;
+        size -= count;
+    }
+}
+
+template<typename T>
+    requires vsl::one_of_type<T, Poco::BinaryReader, Poco::BinaryWriter>
+auto TcpClient::check_stream_status(T& stream) const -> void
+{
+    if constexpr (requires { stream.eof(); })
+    {
+        if (stream.eof())
+        {
+            throw TcpClientGracefulShutdown{};
+        }
+    }
+
+    if (stream.bad())
+    {
+        throw TcpClientConnectionReset{};
+    }
+
+    if (!stream.good())
+    {
+        throw TcpClientError{"Unknown stream error"};
+    }
+}
+
 inline auto TcpClient::wait_for_disconnect() -> void
 {
+    push_coalesced();
+
+    if (direct_receive_enabled_)
+    {
+        try
+        {
+            while (true)
+            {
+                receive_buffer_.consume(receive_buffer_.size());
+                ensure_received(1);
+            }
+        }
+        catch (const TcpClientDisconnect&)
+        {
+        }
+        return;
+    }
+
     constexpr auto MAX_STREAM_SIZE = std::numeric_limits<std::streamsize>::max();
     binary_reader_->stream().ignore(MAX_STREAM_SIZE);
 }
 
+inline auto TcpClient::wait_for_disconnect(Deadline deadline) -> void
+{
+    push_coalesced();
+
+    try
+    {
+        while (true)
+        {
+            if (direct_receive_enabled_)
+            {
+                receive_buffer_.consume(receive_buffer_.size());
+                ensure_received(1, deadline);
+            }
+            else
+            {
+                // Not ignore(), it waits for one more byte
+                auto buffer = std::array<std::byte, 4096>{};
+                auto size = std::clamp(binary_reader_->available(), std::streamsize{1}, std::ssize(buffer));
+                receive_stream(buffer.data(), vsl::as_unsigned(size), deadline);
+            }
+        }
+    }
+    catch (const TcpClientDisconnect&)
+    {
+    }
+}
+
 inline auto TcpClient::data_available() -> int
 {
     auto in_stream = vsl::checked_cast<int>(binary_reader_->available());
+    auto in_receive_buffer = vsl::checked_cast<int>(receive_buffer_.size());
     auto in_socket = socket_.available();
-    auto total = in_stream + in_socket;
+    auto total = in_stream + in_receive_buffer + in_socket;
     if (total > 0) return total;
     check_connection();
     return 0;
@@ -374,14 +1451,17 @@ inline auto TcpClient::set_send_buffer_size(int size) -> void
 
 inline auto TcpClient::get_local_endpoint() const -> std::pair<std::string, int>
 {
-    auto socket_addr = socket_.address();
-    return std::pair{socket_addr.host().toString(), socket_addr.port()};
+    return detail::to_endpoint(socket_.address());
 }
 
 inline auto TcpClient::get_remote_endpoint() const -> std::pair<std::string, int>
 {
-    auto socket_addr = socket_.peerAddress();
-    return std::pair{socket_addr.host().toString(), socket_addr.port()};
+    return detail::to_endpoint(socket_.peerAddress());
+}
+
+inline auto TcpClient::get_transport() const -> Transport
+{
+    return transport_;
 }
 
 }  // namespace vsl::tcp
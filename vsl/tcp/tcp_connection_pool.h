@@ -0,0 +1,129 @@
+#ifndef VSL_TCP_TCP_CONNECTION_POOL_H
+#define VSL_TCP_TCP_CONNECTION_POOL_H
+
+#include "tcp_client.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+// Keeps idle connected clients per endpoint to skip the connection setup on every request.
+// Idle clients are checked with TcpClient::data_available() before they are handed out
+// (a closed peer or unread data means the client is discarded).
+// A background thread evicts broken clients and clients idle for longer than the idle timeout
+// (above min idle) and reconnects up to min idle. Leases must not outlive the pool.
+// New connections are made with the connect timeout, so the pool shutdown never waits
+// for the OS one on an unreachable endpoint.
+class TcpConnectionPool final
+{
+  public:
+    using Endpoint = std::pair<std::string, int>;
+
+    // Returns the client to the pool on destruction
+    class Lease final
+    {
+      public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease();
+
+        auto operator*() -> TcpClient&;
+        auto operator->() -> TcpClient*;
+        auto client() -> TcpClient&;
+
+        // Closes the client instead of returning it (e.g. after a protocol error)
+        auto discard() -> void;
+
+      private:
+        friend class TcpConnectionPool;
+
+        Lease(TcpConnectionPool& pool, Endpoint endpoint, TcpClient client);
+
+        auto release() noexcept -> void;
+
+        TcpConnectionPool* pool_;
+        Endpoint endpoint_;
+        std::optional<TcpClient> client_;
+    };
+
+    explicit TcpConnectionPool(TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE);
+
+    TcpConnectionPool(const TcpConnectionPool&) = delete;
+    TcpConnectionPool& operator=(const TcpConnectionPool&) = delete;
+
+    ~TcpConnectionPool();
+
+    auto acquire(const Endpoint& endpoint) -> Lease;
+    auto acquire(const std::string& host, int port) -> Lease;
+
+    auto set_min_idle(size_t count) -> void;
+    auto set_max_idle(size_t count) -> void;
+    auto set_idle_timeout(std::chrono::milliseconds timeout) -> void;
+    auto set_eviction_interval(std::chrono::milliseconds interval) -> void;
+    auto set_connect_timeout(std::chrono::milliseconds timeout) -> void;
+
+    // Runs an eviction pass immediately
+    auto evict() -> void;
+    auto clear() -> void;
+
+    auto idle_count() const -> size_t;
+    auto idle_count(const Endpoint& endpoint) const -> size_t;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct IdleClient
+    {
+        TcpClient client;
+        Clock::time_point idle_since;
+    };
+
+    static inline constexpr auto DEFAULT_MAX_IDLE = size_t{8};
+    static inline constexpr auto DEFAULT_IDLE_TIMEOUT = std::chrono::milliseconds{60'000};
+    static inline constexpr auto DEFAULT_EVICTION_INTERVAL = std::chrono::milliseconds{5'000};
+    static inline constexpr auto DEFAULT_CONNECT_TIMEOUT = std::chrono::milliseconds{5'000};
+
+    static auto is_healthy(TcpClient& client) -> bool;
+
+    auto take_idle(const Endpoint& endpoint) -> std::optional<TcpClient>;
+    auto check_idle(const Endpoint& endpoint) -> void;
+    auto fill_idle(const Endpoint& endpoint) -> void;
+    auto connect(const Endpoint& endpoint) -> TcpClient;
+    auto give_back(const Endpoint& endpoint, TcpClient client) -> void;
+    auto run_evictor() -> void;
+
+    TcpClient::ByteOrder byte_order_;
+
+    mutable std::mutex mutex_{};
+    std::map<Endpoint, std::deque<IdleClient>> idle_clients_{};
+    size_t min_idle_{0};
+    size_t max_idle_{DEFAULT_MAX_IDLE};
+    std::chrono::milliseconds idle_timeout_{DEFAULT_IDLE_TIMEOUT};
+    std::chrono::milliseconds eviction_interval_{DEFAULT_EVICTION_INTERVAL};
+    std::chrono::milliseconds connect_timeout_{DEFAULT_CONNECT_TIMEOUT};
+
+    std::condition_variable evictor_cv_{};
+    bool stop_requested_{false};
+    std::future<void> evictor_{};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_connection_pool_impl.h"
+
+#endif  // VSL_TCP_TCP_CONNECTION_POOL_H
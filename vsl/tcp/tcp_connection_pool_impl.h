@@ -0,0 +1,358 @@
+#ifndef VSL_TCP_TCP_CONNECTION_POOL_IMPL_H
+#define VSL_TCP_TCP_CONNECTION_POOL_IMPL_H
+
+#include <vsl/threading.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+inline TcpConnectionPool::Lease::Lease(TcpConnectionPool& pool, Endpoint endpoint, TcpClient client)
+    : pool_{&pool},
+      endpoint_{std::move(endpoint)},
+      client_{std::move(client)}
+{}
+
+inline TcpConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_{other.pool_},
+      endpoint_{std::move(other.endpoint_)},
+      client_{std::exchange(other.client_, std::nullopt)}
+{}
+
+inline auto TcpConnectionPool::Lease::operator=(Lease&& other) noexcept -> Lease&
+{
+    if (this != &other)
+    {
+        release();
+        pool_ = other.pool_;
+        endpoint_ = std::move(other.endpoint_);
+        client_ = std::exchange(other.client_, std::nullopt);
+    }
+    return *this;
+}
+
+inline TcpConnectionPool::Lease::~Lease()
+{
+    release();
+}
+
+inline auto TcpConnectionPool::Lease::operator*() -> TcpClient&
+{
+    return client();
+}
+
+inline auto TcpConnectionPool::Lease::operator->() -> TcpClient*
+{
+    return &client();
+}
+
+inline auto TcpConnectionPool::Lease::client() -> TcpClient&
+{
+    if (!client_)
+    {
+        throw TcpClientError{"Lease is released"};
+    }
+    return *client_;
+}
+
+inline auto TcpConnectionPool::Lease::discard() -> void
+{
+    if (!client_) return;
+
+    auto client = std::exchange(client_, std::nullopt);
+    client->close();
+}
+
+inline auto TcpConnectionPool::Lease::release() noexcept -> void
+{
+    if (!client_) return;
+
+    try
+    {
+        pool_->give_back(endpoint_, std::move(*client_));
+    }
+    catch (...)
+    {
+    }
+    client_.reset();
+}
+
+inline TcpConnectionPool::TcpConnectionPool(TcpClient::ByteOrder byte_order)
+    : byte_order_{byte_order}
+{
+    evictor_ = vsl::run_async(&TcpConnectionPool::run_evictor, this);
+}
+
+inline TcpConnectionPool::~TcpConnectionPool()
+{
+    {
+        auto _ = std::scoped_lock(mutex_);
+        stop_requested_ = true;
+    }
+    evictor_cv_.notify_one();
+    evictor_.wait();
+}
+
+inline auto TcpConnectionPool::acquire(const Endpoint& endpoint) -> Lease
+{
+    while (auto client = take_idle(endpoint))
+    {
+        if (is_healthy(*client))
+        {
+            return Lease{*this, endpoint, std::move(*client)};
+        }
+    }
+    return Lease{*this, endpoint, connect(endpoint)};
+}
+
+inline auto TcpConnectionPool::acquire(const std::string& host, int port) -> Lease
+{
+    return acquire(Endpoint{host, port});
+}
+
+// Most recently used first, the oldest clients are left for the eviction
+inline auto TcpConnectionPool::take_idle(const Endpoint& endpoint) -> std::optional<TcpClient>
+{
+    auto _ = std::scoped_lock(mutex_);
+
+    auto it = idle_clients_.find(endpoint);
+    if (it == idle_clients_.end() || it->second.empty()) return std::nullopt;
+
+    auto client = std::move(it->second.back().client);
+    it->second.pop_back();
+    return client;
+}
+
+inline auto TcpConnectionPool::connect(const Endpoint& endpoint) -> TcpClient
+{
+    auto timeout = std::chrono::milliseconds{};
+    {
+        auto _ = std::scoped_lock(mutex_);
+        timeout = connect_timeout_;
+    }
+
+    auto client = TcpClient{byte_order_};
+    client.connect(endpoint, timeout);
+    return client;
+}
+
+inline auto TcpConnectionPool::give_back(const Endpoint& endpoint, TcpClient client) -> void
+{
+    if (client.is_active() && client.buffer_empty())
+    {
+        auto _ = std::scoped_lock(mutex_);
+
+        auto& idle = idle_clients_[endpoint];
+        if (idle.size() < max_idle_)
+        {
+            idle.push_back(IdleClient{std::move(client), Clock::now()});
+            return;
+        }
+    }
+
+    if (client.is_active()) client.close();
+}
+
+inline auto TcpConnectionPool::is_healthy(TcpClient& client) -> bool
+{
+    try
+    {
+        return client.is_active() && client.data_available() == 0;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+inline auto TcpConnectionPool::set_min_idle(size_t count) -> void
+{
+    auto _ = std::scoped_lock(mutex_);
+    min_idle_ = count;
+}
+
+inline auto TcpConnectionPool::set_max_idle(size_t count) -> void
+{
+    auto _ = std::scoped_lock(mutex_);
+    max_idle_ = count;
+}
+
+inline auto TcpConnectionPool::set_idle_timeout(std::chrono::milliseconds timeout) -> void
+{
+    auto _ = std::scoped_lock(mutex_);
+    idle_timeout_ = timeout;
+}
+
+inline auto TcpConnectionPool::set_eviction_interval(std::chrono::milliseconds interval) -> void
+{
+    {
+        auto _ = std::scoped_lock(mutex_);
+        eviction_interval_ = interval;
+    }
+    evictor_cv_.notify_one();
+}
+
+inline auto TcpConnectionPool::set_connect_timeout(std::chrono::milliseconds timeout) -> void
+{
+    auto _ = std::scoped_lock(mutex_);
+    connect_timeout_ = timeout;
+}
+
+// Health checks and reconnects run outside the lock, one client at a time,
+// so acquire() still finds the rest of the idle clients meanwhile
+inline auto TcpConnectionPool::evict() -> void
+{
+    auto endpoints = std::vector<Endpoint>{};
+    auto evicted = std::vector<IdleClient>{};
+    {
+        auto _ = std::scoped_lock(mutex_);
+        auto now = Clock::now();
+        for (auto& [endpoint, idle] : idle_clients_)
+        {
+            endpoints.push_back(endpoint);
+
+            // Oldest first
+            while (idle.size() > min_idle_ && now - idle.front().idle_since > idle_timeout_)
+            {
+                evicted.push_back(std::move(idle.front()));
+                idle.pop_front();
+            }
+        }
+    }
+    evicted.clear();
+
+    for (const auto& endpoint : endpoints)
+    {
+        check_idle(endpoint);
+    }
+
+    // After the checked clients are back, so they are not replaced by new connections
+    for (const auto& endpoint : endpoints)
+    {
+        fill_idle(endpoint);
+    }
+}
+
+// Only the front may shift under 'pos': acquire() and give_back() work at the back
+inline auto TcpConnectionPool::check_idle(const Endpoint& endpoint) -> void
+{
+    auto pos = size_t{0};
+    while (true)
+    {
+        auto item = std::optional<IdleClient>{};
+        {
+            auto _ = std::scoped_lock(mutex_);
+            auto it = idle_clients_.find(endpoint);
+            if (it == idle_clients_.end() || pos >= it->second.size()) return;
+
+            auto item_it = it->second.begin() + static_cast<std::ptrdiff_t>(pos);
+            item = std::move(*item_it);
+            it->second.erase(item_it);
+        }
+
+        if (!is_healthy(item->client)) continue;
+
+        auto _ = std::scoped_lock(mutex_);
+        auto& idle = idle_clients_[endpoint];
+        if (idle.size() >= max_idle_) continue;
+
+        pos = std::min(pos, idle.size());
+        idle.insert(idle.begin() + static_cast<std::ptrdiff_t>(pos), std::move(*item));
+        ++pos;
+    }
+}
+
+inline auto TcpConnectionPool::fill_idle(const Endpoint& endpoint) -> void
+{
+    while (true)
+    {
+        {
+            auto _ = std::scoped_lock(mutex_);
+            if (stop_requested_) return;
+
+            auto it = idle_clients_.find(endpoint);
+            auto idle_count = (it != idle_clients_.end()) ? it->second.size() : 0;
+            if (idle_count >= std::min(min_idle_, max_idle_)) return;
+        }
+
+        auto client = std::optional<TcpClient>{};
+        try
+        {
+            client = connect(endpoint);
+        }
+        catch (const TcpClientError&)
+        {
+            return;
+        }
+
+        auto _ = std::scoped_lock(mutex_);
+        auto& idle = idle_clients_[endpoint];
+        if (idle.size() >= max_idle_) return;
+
+        idle.push_front(IdleClient{std::move(*client), Clock::now()});
+    }
+}
+
+inline auto TcpConnectionPool::clear() -> void
+{
+    auto _ = std::scoped_lock(mutex_);
+    for (auto& [endpoint, idle] : idle_clients_)
+    {
+        for (auto& item : idle)
+        {
+            item.client.close();
+        }
+    }
+    idle_clients_.clear();
+}
+
+inline auto TcpConnectionPool::idle_count() const -> size_t
+{
+    auto _ = std::scoped_lock(mutex_);
+    auto count = size_t{0};
+    for (const auto& [endpoint, idle] : idle_clients_)
+    {
+        count += idle.size();
+    }
+    return count;
+}
+
+inline auto TcpConnectionPool::idle_count(const Endpoint& endpoint) const -> size_t
+{
+    auto _ = std::scoped_lock(mutex_);
+    auto it = idle_clients_.find(endpoint);
+    return (it != idle_clients_.end()) ? it->second.size() : 0;
+}
+
+inline auto TcpConnectionPool::run_evictor() -> void
+{
+    auto lock = std::unique_lock(mutex_);
+    while (!stop_requested_)
+    {
+        // A changed interval restarts the wait
+        auto interval = eviction_interval_;
+        evictor_cv_.wait_for(lock, interval, [&] { return stop_requested_ || eviction_interval_ != interval; });
+        if (stop_requested_) break;
+        if (eviction_interval_ != interval) continue;
+
+        lock.unlock();
+        try
+        {
+            evict();
+        }
+        catch (...)
+        {
+        }
+        lock.lock();
+    }
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_CONNECTION_POOL_IMPL_H
@@ -0,0 +1,116 @@
+#ifndef VSL_TCP_TCP_EPOLL_H
+#define VSL_TCP_TCP_EPOLL_H
+
+#include "tcp_client.h"
+
+#include <vsl/os.h>
+#include <vsl/types.h>
+
+#if !defined(VSL_LINUX_OS)
+#error epoll is supported on Linux only
+#endif
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+
+namespace vsl::tcp::detail
+{
+
+// Level-triggered epoll instance with an eventfd to wake up wait() from other threads
+class Epoll final
+{
+  public:
+    static inline constexpr auto WAKEUP_KEY = std::numeric_limits<uint64_t>::max();
+
+    Epoll()
+        : epoll_fd_{epoll_create1(EPOLL_CLOEXEC)}
+    {
+        if (epoll_fd_ < 0) throw_system_error("Failed to create epoll instance");
+
+        wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeup_fd_ < 0)
+        {
+            ::close(epoll_fd_);
+            throw_system_error("Failed to create eventfd");
+        }
+
+        add(wakeup_fd_, EPOLLIN, WAKEUP_KEY);
+    }
+
+    Epoll(const Epoll&) = delete;
+    Epoll& operator=(const Epoll&) = delete;
+
+    ~Epoll()
+    {
+        ::close(wakeup_fd_);
+        ::close(epoll_fd_);
+    }
+
+    auto add(int fd, uint32_t events, uint64_t key) -> void
+    {
+        control(EPOLL_CTL_ADD, fd, events, key);
+    }
+
+    auto modify(int fd, uint32_t events, uint64_t key) -> void
+    {
+        control(EPOLL_CTL_MOD, fd, events, key);
+    }
+
+    auto remove(int fd) noexcept -> void
+    {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    // Returns ready events, wakeup notifications are consumed and not reported
+    auto wait(std::span<epoll_event> events, int timeout_ms) -> std::span<epoll_event>
+    {
+        auto count = epoll_wait(epoll_fd_, events.data(), vsl::checked_cast<int>(events.size()), timeout_ms);
+        if (count < 0)
+        {
+            if (errno == EINTR) return {};
+            throw_system_error("Failed to wait for epoll events");
+        }
+
+        auto ready = events.first(vsl::as_unsigned(count));
+        auto wakeup = std::ranges::find_if(ready, [](const epoll_event& e) { return e.data.u64 == WAKEUP_KEY; });
+        if (wakeup != ready.end())
+        {
+            auto value = uint64_t{};
+            [[maybe_unused]] auto rc = ::read(wakeup_fd_, &value, sizeof(value));
+            std::iter_swap(wakeup, std::prev(ready.end()));
+            ready = ready.first(ready.size() - 1);
+        }
+        return ready;
+    }
+
+    // Thread-safe
+    auto wakeup() noexcept -> void
+    {
+        auto value = uint64_t{1};
+        [[maybe_unused]] auto rc = ::write(wakeup_fd_, &value, sizeof(value));
+    }
+
+  private:
+    auto control(int op, int fd, uint32_t events, uint64_t key) -> void
+    {
+        auto event = epoll_event{};
+        event.events = events;
+        event.data.u64 = key;
+        if (epoll_ctl(epoll_fd_, op, fd, &event) < 0) throw_system_error("Failed to update epoll interest list");
+    }
+
+    int epoll_fd_{-1};
+    int wakeup_fd_{-1};
+};
+
+}  // namespace vsl::tcp::detail
+
+#endif  // VSL_TCP_TCP_EPOLL_H
@@ -0,0 +1,91 @@
+#ifndef VSL_TCP_TCP_FRAMED_CONNECTION_H
+#define VSL_TCP_TCP_FRAMED_CONNECTION_H
+
+#include "tcp_client.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace vsl::tcp
+{
+
+// Message framing over TcpClient with a fixed header: payload length (uint32), type (uint16), request id (uint64).
+// Requests are pipelined: any number of them can be sent before the responses are awaited,
+// responses may arrive in any order and are matched by the request id.
+// Frames are decoded from the client receive buffer (direct receive mode).
+// Request ids are per side, so a connection should be used either for sending requests or for responding.
+// A frame above the max frame size is skipped and reported by TcpClientError, the connection stays usable.
+class FramedConnection final
+{
+  public:
+    // The payload is not copied, it is valid until the next read_message(), wait_response() or call()
+    struct Message
+    {
+        uint16_t type{};
+        uint64_t request_id{};
+        std::string_view payload{};
+    };
+
+    explicit FramedConnection(TcpClient client);
+
+    FramedConnection(FramedConnection&&) = default;
+    FramedConnection& operator=(FramedConnection&&) = default;
+
+    FramedConnection(const FramedConnection&) = delete;
+    FramedConnection& operator=(const FramedConnection&) = delete;
+
+    ~FramedConnection() = default;
+
+    // Writes are buffered until flush()
+    auto send_request(uint16_t type, std::string_view payload) -> uint64_t;
+    auto send_response(uint64_t request_id, uint16_t type, std::string_view payload) -> void;
+    auto flush() -> void;
+
+    // Next received message, messages skipped by wait_response() come first
+    auto read_message() -> Message;
+
+    // Messages with other request ids received meanwhile are kept for read_message() and wait_response()
+    auto wait_response(uint64_t request_id) -> Message;
+
+    // Sends a request and waits for its response
+    auto call(uint16_t type, std::string_view payload) -> Message;
+
+    auto pending_request_count() const -> size_t;
+
+    auto set_max_frame_size(size_t size) -> void;
+    auto client() -> TcpClient&;
+
+  private:
+    // Message received while waiting for another response
+    struct StoredMessage
+    {
+        uint16_t type{};
+        uint64_t request_id{};
+        std::string payload{};
+    };
+
+    static inline constexpr auto DEFAULT_MAX_FRAME_SIZE = size_t{64 * 1024 * 1024};
+    static inline constexpr auto SKIP_CHUNK_SIZE = size_t{64 * 1024};
+
+    auto send_frame(uint16_t type, uint64_t request_id, std::string_view payload) -> void;
+    auto receive_message() -> Message;
+    auto skip_payload(size_t size) -> void;
+    auto take_stored(std::deque<StoredMessage>::iterator it) -> Message;
+
+    TcpClient client_;
+    uint64_t next_request_id_{1};
+    std::unordered_set<uint64_t> pending_requests_{};
+    std::deque<StoredMessage> received_messages_{};
+    std::string stored_payload_{};
+    size_t max_frame_size_{DEFAULT_MAX_FRAME_SIZE};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_framed_connection_impl.h"
+
+#endif  // VSL_TCP_TCP_FRAMED_CONNECTION_H
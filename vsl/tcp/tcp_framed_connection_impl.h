@@ -0,0 +1,144 @@
+#ifndef VSL_TCP_TCP_FRAMED_CONNECTION_IMPL_H
+#define VSL_TCP_TCP_FRAMED_CONNECTION_IMPL_H
+
+#include <vsl/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace vsl::tcp
+{
+
+inline FramedConnection::FramedConnection(TcpClient client)
+    : client_{std::move(client)}
+{
+    client_.enable_direct_receive(true);
+}
+
+inline auto FramedConnection::send_request(uint16_t type, std::string_view payload) -> uint64_t
+{
+    auto request_id = next_request_id_++;
+    send_frame(type, request_id, payload);
+    pending_requests_.insert(request_id);
+    return request_id;
+}
+
+inline auto FramedConnection::send_response(uint64_t request_id, uint16_t type, std::string_view payload) -> void
+{
+    send_frame(type, request_id, payload);
+}
+
+inline auto FramedConnection::send_frame(uint16_t type, uint64_t request_id, std::string_view payload) -> void
+{
+    if (payload.size() > max_frame_size_)
+    {
+        throw TcpClientError{"Frame is too large", std::to_string(payload.size())};
+    }
+
+    client_.write(vsl::checked_cast<uint32_t>(payload.size()));
+    client_.write(type);
+    client_.write(request_id);
+    client_.write_raw(payload.data(), payload.size());
+
+    if (const auto& metrics = client_.get_metrics())
+    {
+        metrics->frames_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline auto FramedConnection::flush() -> void
+{
+    client_.flush();
+}
+
+inline auto FramedConnection::receive_message() -> Message
+{
+    auto size = vsl::checked_cast<size_t>(client_.read<uint32_t>());
+    auto type = client_.read<uint16_t>();
+    auto request_id = client_.read<uint64_t>();
+
+    pending_requests_.erase(request_id);
+
+    if (size > max_frame_size_)
+    {
+        skip_payload(size);
+        throw TcpClientError{"Frame is too large", std::to_string(size)};
+    }
+
+    auto payload = client_.read_span(size);
+
+    if (const auto& metrics = client_.get_metrics())
+    {
+        metrics->frames_received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return Message{type, request_id, std::string_view{reinterpret_cast<const char*>(payload.data()), payload.size()}};
+}
+
+// Reads in chunks, so the receive buffer does not grow to the frame size
+inline auto FramedConnection::skip_payload(size_t size) -> void
+{
+    while (size > 0)
+    {
+        auto chunk_size = std::min(size, SKIP_CHUNK_SIZE);
+        client_.read_span(chunk_size);
+        size -= chunk_size;
+    }
+}
+
+inline auto FramedConnection::take_stored(std::deque<StoredMessage>::iterator it) -> Message
+{
+    stored_payload_ = std::move(it->payload);
+    auto message = Message{it->type, it->request_id, stored_payload_};
+    received_messages_.erase(it);
+    return message;
+}
+
+inline auto FramedConnection::read_message() -> Message
+{
+    if (!received_messages_.empty()) return take_stored(received_messages_.begin());
+    return receive_message();
+}
+
+inline auto FramedConnection::wait_response(uint64_t request_id) -> Message
+{
+    auto it = std::ranges::find(received_messages_, request_id, &StoredMessage::request_id);
+    if (it != received_messages_.end()) return take_stored(it);
+
+    while (true)
+    {
+        auto message = receive_message();
+        if (message.request_id == request_id) return message;
+        received_messages_.push_back(StoredMessage{message.type, message.request_id, std::string{message.payload}});
+    }
+}
+
+inline auto FramedConnection::call(uint16_t type, std::string_view payload) -> Message
+{
+    auto request_id = send_request(type, payload);
+    flush();
+    return wait_response(request_id);
+}
+
+inline auto FramedConnection::pending_request_count() const -> size_t
+{
+    return pending_requests_.size();
+}
+
+inline auto FramedConnection::set_max_frame_size(size_t size) -> void
+{
+    max_frame_size_ = size;
+}
+
+inline auto FramedConnection::client() -> TcpClient&
+{
+    return client_;
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_FRAMED_CONNECTION_IMPL_H
@@ -6,8 +6,13 @@
 #include <Poco/Net/ServerSocket.h>
 #include <Poco/Net/SocketAddress.h>
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace vsl::tcp
 {
@@ -17,26 +22,124 @@ class TcpListenerError : public TcpError
     using TcpError::TcpError;
 };
 
+// Options of the accepted sockets, unset ones are left as is.
+// The exception is no_delay: accepted clients get TCP_NODELAY like connected ones unless it is false.
+struct TcpSocketOptions
+{
+    std::optional<int> receive_buffer_size{};
+    std::optional<int> send_buffer_size{};
+    std::optional<bool> keep_alive{};
+    std::optional<bool> no_delay{};
+
+    // SO_BUSY_POLL in microseconds, above net.core.busy_read it needs CAP_NET_ADMIN (Linux only, ignored elsewhere)
+    std::optional<int> busy_poll{};
+
+    // Small send buffer: less data queued ahead of a new message
+    static auto low_latency() -> TcpSocketOptions
+    {
+        return TcpSocketOptions{.send_buffer_size = 64 * 1024, .no_delay = true};
+    }
+
+    static auto high_throughput() -> TcpSocketOptions
+    {
+        return TcpSocketOptions{.receive_buffer_size = 4 * 1024 * 1024, .send_buffer_size = 4 * 1024 * 1024};
+    }
+};
+
+namespace detail
+{
+
+// Owns a UNIX socket file: removes it on destruction, the ownership moves with the object
+class SocketFile final
+{
+  public:
+    SocketFile() = default;
+    explicit SocketFile(std::string path) noexcept;
+
+    SocketFile(SocketFile&& other) noexcept;
+    SocketFile& operator=(SocketFile&& other) noexcept;
+
+    SocketFile(const SocketFile&) = delete;
+    SocketFile& operator=(const SocketFile&) = delete;
+
+    ~SocketFile();
+
+    auto remove() noexcept -> void;
+
+  private:
+    std::string path_{};
+};
+
+}  // namespace detail
+
 class TcpListener final
 {
   public:
-    TcpListener() = default;
+    // The clients accepted by a UNIX transport listener are of the UNIX transport too
+    explicit TcpListener(TcpClient::Transport transport = TcpClient::Transport::TCP);
+
+    // Move assignment removes the socket file of the assigned-to listener
+    TcpListener(TcpListener&&) = default;
+    TcpListener& operator=(TcpListener&&) = default;
+
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    // Removes the socket file of a UNIX transport listener
+    ~TcpListener() = default;
 
     auto start(int port) -> void;
     auto start(const std::pair<std::string, int>& endpoint) -> void;
     auto start(const std::string& ip, int port) -> void;
+
+    // "ip:port" or the socket file path for the UNIX transport, the file must not exist and is removed by stop()
+    // (or the destructor)
     auto start(const std::string& endpoint) -> void;
     auto stop() -> void;
     auto accept_client(TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE) -> TcpClient;
+
+    // Waits for a client, then takes the ones already queued by the kernel, up to max_count.
+    // Throws only if the first accept fails, a later failure ends the batch.
+    auto accept_clients(size_t max_count, TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE)
+        -> std::vector<TcpClient>;
     auto get_port() -> int;
+    auto get_local_endpoint() const -> std::pair<std::string, int>;
     auto is_listening() const -> bool;
 
+    // SO_REUSEPORT: several listeners may bind the same endpoint, the kernel balances connections between them
+    auto set_reuse_port(bool state) -> void;
+
+    // Must be called before start(): the buffer sizes and keep-alive are set once on the listening socket
+    // (the accepted sockets inherit them), the others on each accepted socket
+    auto set_client_options(const TcpSocketOptions& options) -> void;
+
+    // Size of the queue of connections not yet accepted, must be called before start()
+    auto set_backlog(int backlog) -> void;
+
+    // Counts accepted clients and is attached to them (see TcpClient::set_metrics())
+    auto set_metrics(std::shared_ptr<TcpMetrics> metrics) -> void;
+
   private:
+    friend class AsyncTcpListener;
+    friend class TcpServer;
+    friend class TcpShardedListener;
+
+    static inline constexpr auto DEFAULT_BACKLOG = 64;
+
     auto start(Poco::Net::SocketAddress socket_addr) -> void;
     auto throw_start_error(std::string_view error_desc) -> void;
+    auto check_tcp_transport() -> void;
+    auto accept_socket(bool wait) -> std::optional<Poco::Net::StreamSocket>;
+    auto make_client(Poco::Net::StreamSocket socket, TcpClient::ByteOrder byte_order) -> TcpClient;
 
+    TcpClient::Transport transport_{TcpClient::Transport::TCP};
     Poco::Net::ServerSocket server_socket_{};
+    detail::SocketFile socket_file_{};
     bool is_listening_{false};
+    bool reuse_port_{false};
+    int backlog_{DEFAULT_BACKLOG};
+    TcpSocketOptions client_options_{};
+    std::shared_ptr<TcpMetrics> metrics_{};
 };
 
 }  // namespace vsl::tcp
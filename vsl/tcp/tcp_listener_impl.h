@@ -1,20 +1,75 @@
 #ifndef VSL_TCP_TCP_LISTENER_IMPL_H
 #define VSL_TCP_TCP_LISTENER_IMPL_H
 
+#include <vsl/os.h>
 #include <vsl/types.h>
 
 #include <Poco/Exception.h>
 #include <Poco/Net/SocketAddress.h>
+#include <Poco/Timespan.h>
 
+#if defined(VSL_LINUX_OS)
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
 #include <cstdint>
+#include <filesystem>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 
 namespace vsl::tcp
 {
 
+namespace detail
+{
+
+inline SocketFile::SocketFile(std::string path) noexcept
+    : path_{std::move(path)}
+{}
+
+inline SocketFile::SocketFile(SocketFile&& other) noexcept
+    : path_{std::exchange(other.path_, {})}
+{}
+
+inline SocketFile& SocketFile::operator=(SocketFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        remove();
+        path_ = std::exchange(other.path_, {});
+    }
+    return *this;
+}
+
+inline SocketFile::~SocketFile()
+{
+    remove();
+}
+
+inline auto SocketFile::remove() noexcept -> void
+{
+    if (path_.empty()) return;
+
+    auto error = std::error_code{};
+    std::filesystem::remove(path_, error);
+    path_.clear();
+}
+
+}  // namespace detail
+
+inline TcpListener::TcpListener(TcpClient::Transport transport)
+    : transport_{transport}
+{}
+
 inline auto TcpListener::start(int port) -> void
 {
+    check_tcp_transport();
+
     try
     {
         const auto socket_addr = Poco::Net::SocketAddress{vsl::checked_cast<uint16_t>(port)};
@@ -33,6 +88,8 @@ inline auto TcpListener::start(const std::pair<std::string, int>& endpoint) -> v
 
 inline auto TcpListener::start(const std::string& ip, int port) -> void
 {
+    check_tcp_transport();
+
     try
     {
         const auto socket_addr = Poco::Net::SocketAddress{ip, vsl::checked_cast<uint16_t>(port)};
@@ -48,6 +105,13 @@ inline auto TcpListener::start(const std::string& endpoint) -> void
 {
     try
     {
+        if (transport_ == TcpClient::Transport::UNIX)
+        {
+            start(Poco::Net::SocketAddress{Poco::Net::SocketAddress::UNIX_LOCAL, endpoint});
+            socket_file_ = detail::SocketFile{endpoint};
+            return;
+        }
+
         const auto socket_addr = Poco::Net::SocketAddress{endpoint};
         start(socket_addr);
     }
@@ -64,8 +128,22 @@ inline auto TcpListener::start(Poco::Net::SocketAddress socket_addr) -> void
         throw_start_error("Already listening");
     }
 
-    server_socket_.bind(socket_addr);
-    server_socket_.listen();
+    server_socket_.bind(socket_addr, false, reuse_port_);
+
+    if (client_options_.receive_buffer_size) server_socket_.setReceiveBufferSize(*client_options_.receive_buffer_size);
+    if (client_options_.send_buffer_size) server_socket_.setSendBufferSize(*client_options_.send_buffer_size);
+    if (client_options_.keep_alive && transport_ == TcpClient::Transport::TCP)
+    {
+        server_socket_.setKeepAlive(*client_options_.keep_alive);
+    }
+
+    server_socket_.listen(backlog_);
+
+#if defined(VSL_LINUX_OS)
+    // Lets accept_clients() drain the queue, the waits are done by poll()
+    server_socket_.setBlocking(false);
+#endif
+
     is_listening_ = true;
 }
 
@@ -74,6 +152,14 @@ inline auto TcpListener::throw_start_error(std::string_view error_desc) -> void
     throw TcpListenerError{"Failed to start listening", error_desc};
 }
 
+inline auto TcpListener::check_tcp_transport() -> void
+{
+    if (transport_ != TcpClient::Transport::TCP)
+    {
+        throw_start_error("IP and port are used by the TCP transport only");
+    }
+}
+
 inline auto TcpListener::stop() -> void
 {
     try
@@ -85,15 +171,105 @@ inline auto TcpListener::stop() -> void
         throw TcpListenerError{"Failed to stop listening", ex.displayText()};
     }
 
+    socket_file_.remove();
     is_listening_ = false;
 }
 
 inline auto TcpListener::accept_client(TcpClient::ByteOrder byte_order) -> TcpClient
 {
+    return make_client(*accept_socket(true), byte_order);
+}
+
+inline auto TcpListener::accept_clients(size_t max_count, TcpClient::ByteOrder byte_order) -> std::vector<TcpClient>
+{
+    auto clients = std::vector<TcpClient>{};
+    if (max_count == 0) return clients;
+
+    clients.push_back(make_client(*accept_socket(true), byte_order));
+
+    while (clients.size() < max_count)
+    {
+        try
+        {
+            auto socket = accept_socket(false);
+            if (!socket) break;
+            clients.push_back(make_client(std::move(*socket), byte_order));
+        }
+        catch (const TcpError&)
+        {
+            // The clients already accepted are returned, a persistent error (e.g. EMFILE) is thrown by the next call
+            break;
+        }
+    }
+
+    return clients;
+}
+
+// Returns nullopt if no connection is queued and wait is false.
+// The accepted sockets are blocking (used by the TcpClient streams), so SOCK_NONBLOCK is not set.
+inline auto TcpListener::accept_socket(bool wait) -> std::optional<Poco::Net::StreamSocket>
+{
+#if defined(VSL_LINUX_OS)
+    const auto listener_fd = server_socket_.impl()->sockfd();
+
+    while (true)
+    {
+        auto fd = ::accept4(listener_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0)
+        {
+            return detail::wrap_socket_fd(fd);
+        }
+
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            throw TcpListenerError{"Failed to accept client", std::generic_category().message(errno)};
+        }
+        if (!wait) return std::nullopt;
+
+        auto poll_fd = pollfd{.fd = listener_fd, .events = POLLIN, .revents = 0};
+        if (::poll(&poll_fd, 1, -1) < 0 && errno != EINTR)
+        {
+            throw TcpListenerError{"Failed to accept client", std::generic_category().message(errno)};
+        }
+    }
+#else
     try
     {
-        auto client_socket = server_socket_.acceptConnection();
-        return TcpClient{client_socket, byte_order};
+        if (!wait && !server_socket_.poll(Poco::Timespan{0}, Poco::Net::Socket::SELECT_READ)) return std::nullopt;
+        return server_socket_.acceptConnection();
+    }
+    catch (const Poco::Exception& ex)
+    {
+        throw TcpListenerError{"Failed to accept client", ex.displayText()};
+    }
+#endif
+}
+
+inline auto TcpListener::make_client(Poco::Net::StreamSocket socket, TcpClient::ByteOrder byte_order) -> TcpClient
+{
+    try
+    {
+        auto client = TcpClient{std::move(socket), byte_order, transport_};
+
+        if (transport_ == TcpClient::Transport::TCP)
+        {
+            // The only per-socket call by default: TCP_NODELAY backs the IMMEDIATE flush policy
+            client.socket_.setNoDelay(client_options_.no_delay.value_or(true));
+#if defined(VSL_LINUX_OS)
+            if (client_options_.busy_poll)
+            {
+                client.socket_.setOption(SOL_SOCKET, SO_BUSY_POLL, *client_options_.busy_poll);
+            }
+#endif
+        }
+
+        if (metrics_)
+        {
+            metrics_->accept_count.fetch_add(1, std::memory_order_relaxed);
+            client.set_metrics(metrics_);
+        }
+        return client;
     }
     catch (const Poco::Exception& ex)
     {
@@ -103,7 +279,12 @@ inline auto TcpListener::accept_client(TcpClient::ByteOrder byte_order) -> TcpCl
 
 inline auto TcpListener::get_port() -> int
 {
-    return server_socket_.address().port();
+    return detail::to_endpoint(server_socket_.address()).second;
+}
+
+inline auto TcpListener::get_local_endpoint() const -> std::pair<std::string, int>
+{
+    return detail::to_endpoint(server_socket_.address());
 }
 
 inline auto TcpListener::is_listening() const -> bool
@@ -111,6 +292,34 @@ inline auto TcpListener::is_listening() const -> bool
     return is_listening_;
 }
 
+inline auto TcpListener::set_reuse_port(bool state) -> void
+{
+    reuse_port_ = state;
+}
+
+inline auto TcpListener::set_client_options(const TcpSocketOptions& options) -> void
+{
+    if (is_listening_)
+    {
+        throw TcpListenerError{"Failed to set client options", "Already listening"};
+    }
+    client_options_ = options;
+}
+
+inline auto TcpListener::set_backlog(int backlog) -> void
+{
+    if (is_listening_)
+    {
+        throw TcpListenerError{"Failed to set backlog", "Already listening"};
+    }
+    backlog_ = backlog;
+}
+
+inline auto TcpListener::set_metrics(std::shared_ptr<TcpMetrics> metrics) -> void
+{
+    metrics_ = std::move(metrics);
+}
+
 }  // namespace vsl::tcp
 
 #endif  // VSL_TCP_TCP_LISTENER_IMPL_H
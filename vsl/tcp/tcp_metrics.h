@@ -0,0 +1,139 @@
+#ifndef VSL_TCP_TCP_METRICS_H
+#define VSL_TCP_TCP_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace vsl::tcp
+{
+
+struct LatencySnapshot
+{
+    uint64_t count{};
+    uint64_t min_ns{};
+    uint64_t mean_ns{};
+    uint64_t p50_ns{};
+    uint64_t p90_ns{};
+    uint64_t p99_ns{};
+    uint64_t p999_ns{};
+    uint64_t max_ns{};
+};
+
+struct TcpMetricsSnapshot
+{
+    uint64_t bytes_sent{};
+    uint64_t bytes_received{};
+    uint64_t frames_sent{};
+    uint64_t frames_received{};
+    uint64_t flush_count{};
+    uint64_t accept_count{};
+    double accept_rate{};
+    LatencySnapshot read_latency{};
+    LatencySnapshot write_latency{};
+    LatencySnapshot flush_latency{};
+};
+
+// Log-linear histogram in the HDR style: values are grouped by powers of two, each split into
+// SUB_BUCKET_COUNT linear sub-buckets, so percentiles are within 1/SUB_BUCKET_COUNT (3%) of the actual value
+// over the whole range. Recording is lock-free.
+class LatencyHistogram final
+{
+  public:
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    ~LatencyHistogram() = default;
+
+    auto record(std::chrono::nanoseconds latency) noexcept -> void;
+
+    // Values recorded concurrently may be partially included
+    auto snapshot() const -> LatencySnapshot;
+    auto reset() noexcept -> void;
+
+  private:
+    static inline constexpr auto SUB_BUCKET_BITS = 5;
+    static inline constexpr auto SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+    static inline constexpr auto BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    static auto bucket_index(uint64_t value) noexcept -> size_t;
+    static auto bucket_highest_value(size_t index) noexcept -> uint64_t;
+
+    auto percentile(double percent, uint64_t count) const -> uint64_t;
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_{0};
+};
+
+// Counters and latencies of the clients and listeners it is attached to (opt-in, see TcpClient::set_metrics()).
+// Can be shared between many clients to get totals, all updates are relaxed atomics.
+// Bytes are counted when they are passed to the socket or read from it, so buffered writes are counted
+// on write_buffer(). Latencies are the time spent in the socket reads, writes and flushes.
+// Without direct receive, reads go through the stream buffer: the bytes are counted when the buffer takes them
+// from the socket, and only the reads that refill the buffer are timed (a read served by the buffer is not).
+// Frames are counted by the framing layers: TcpSender, FramedConnection and TcpClient::read_frame().
+class TcpMetrics final
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    TcpMetrics();
+
+    TcpMetrics(const TcpMetrics&) = delete;
+    TcpMetrics& operator=(const TcpMetrics&) = delete;
+
+    ~TcpMetrics() = default;
+
+    // Accept rate is per second since the creation or the last reset
+    auto snapshot() const -> TcpMetricsSnapshot;
+    auto reset() noexcept -> void;
+
+    std::atomic<uint64_t> bytes_sent{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> frames_sent{0};
+    std::atomic<uint64_t> frames_received{0};
+    std::atomic<uint64_t> flush_count{0};
+    std::atomic<uint64_t> accept_count{0};
+
+    LatencyHistogram read_latency{};
+    LatencyHistogram write_latency{};
+    LatencyHistogram flush_latency{};
+
+  private:
+    std::atomic<Clock::rep> start_time_{};
+};
+
+namespace detail
+{
+
+// Records the lifetime to the histogram, does nothing without one
+class LatencyTimer final
+{
+  public:
+    explicit LatencyTimer(LatencyHistogram* histogram) noexcept;
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+    ~LatencyTimer();
+
+  private:
+    LatencyHistogram* histogram_;
+    TcpMetrics::Clock::time_point start_{};
+};
+
+}  // namespace detail
+
+}  // namespace vsl::tcp
+
+#include "tcp_metrics_impl.h"
+
+#endif  // VSL_TCP_TCP_METRICS_H
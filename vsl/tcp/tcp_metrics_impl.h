@@ -0,0 +1,154 @@
+#ifndef VSL_TCP_TCP_METRICS_IMPL_H
+#define VSL_TCP_TCP_METRICS_IMPL_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace vsl::tcp
+{
+
+inline auto LatencyHistogram::record(std::chrono::nanoseconds latency) noexcept -> void
+{
+    auto value = static_cast<uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0}));
+
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    auto min = min_.load(std::memory_order_relaxed);
+    while (value < min && !min_.compare_exchange_weak(min, value, std::memory_order_relaxed))
+    {
+    }
+
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+inline auto LatencyHistogram::snapshot() const -> LatencySnapshot
+{
+    auto count = count_.load(std::memory_order_relaxed);
+    if (count == 0) return LatencySnapshot{};
+
+    return LatencySnapshot{
+        .count = count,
+        .min_ns = min_.load(std::memory_order_relaxed),
+        .mean_ns = sum_.load(std::memory_order_relaxed) / count,
+        .p50_ns = percentile(50.0, count),
+        .p90_ns = percentile(90.0, count),
+        .p99_ns = percentile(99.0, count),
+        .p999_ns = percentile(99.9, count),
+        .max_ns = max_.load(std::memory_order_relaxed),
+    };
+}
+
+inline auto LatencyHistogram::reset() noexcept -> void
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// Values below SUB_BUCKET_COUNT are exact, above that the bucket width doubles with each power of two
+inline auto LatencyHistogram::bucket_index(uint64_t value) noexcept -> size_t
+{
+    if (value < SUB_BUCKET_COUNT) return static_cast<size_t>(value);
+
+    auto shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+    auto sub_bucket = static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+    return (static_cast<size_t>(shift) + 1) * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+inline auto LatencyHistogram::bucket_highest_value(size_t index) noexcept -> uint64_t
+{
+    if (index < SUB_BUCKET_COUNT) return index;
+
+    auto shift = index / SUB_BUCKET_COUNT - 1;
+    auto sub_bucket = index % SUB_BUCKET_COUNT;
+    auto lowest = uint64_t{SUB_BUCKET_COUNT + sub_bucket} << shift;
+    return lowest + ((uint64_t{1} << shift) - 1);
+}
+
+inline auto LatencyHistogram::percentile(double percent, uint64_t count) const -> uint64_t
+{
+    auto rank = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(count)));
+    rank = std::clamp(rank, uint64_t{1}, count);
+
+    auto seen = uint64_t{0};
+    for (auto index = size_t{0}; index < buckets_.size(); ++index)
+    {
+        seen += buckets_[index].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return std::min(bucket_highest_value(index), max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+inline TcpMetrics::TcpMetrics()
+    : start_time_{Clock::now().time_since_epoch().count()}
+{}
+
+inline auto TcpMetrics::snapshot() const -> TcpMetricsSnapshot
+{
+    auto start_time = Clock::time_point{Clock::duration{start_time_.load(std::memory_order_relaxed)}};
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start_time).count();
+    auto accept_count_value = accept_count.load(std::memory_order_relaxed);
+
+    return TcpMetricsSnapshot{
+        .bytes_sent = bytes_sent.load(std::memory_order_relaxed),
+        .bytes_received = bytes_received.load(std::memory_order_relaxed),
+        .frames_sent = frames_sent.load(std::memory_order_relaxed),
+        .frames_received = frames_received.load(std::memory_order_relaxed),
+        .flush_count = flush_count.load(std::memory_order_relaxed),
+        .accept_count = accept_count_value,
+        .accept_rate = (elapsed > 0.0) ? static_cast<double>(accept_count_value) / elapsed : 0.0,
+        .read_latency = read_latency.snapshot(),
+        .write_latency = write_latency.snapshot(),
+        .flush_latency = flush_latency.snapshot(),
+    };
+}
+
+inline auto TcpMetrics::reset() noexcept -> void
+{
+    bytes_sent.store(0, std::memory_order_relaxed);
+    bytes_received.store(0, std::memory_order_relaxed);
+    frames_sent.store(0, std::memory_order_relaxed);
+    frames_received.store(0, std::memory_order_relaxed);
+    flush_count.store(0, std::memory_order_relaxed);
+    accept_count.store(0, std::memory_order_relaxed);
+
+    read_latency.reset();
+    write_latency.reset();
+    flush_latency.reset();
+
+    start_time_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+namespace detail
+{
+
+inline LatencyTimer::LatencyTimer(LatencyHistogram* histogram) noexcept
+    : histogram_{histogram}
+{
+    if (histogram_) start_ = TcpMetrics::Clock::now();
+}
+
+inline LatencyTimer::~LatencyTimer()
+{
+    if (histogram_) histogram_->record(TcpMetrics::Clock::now() - start_);
+}
+
+}  // namespace detail
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_METRICS_IMPL_H
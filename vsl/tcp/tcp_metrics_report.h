@@ -0,0 +1,89 @@
+#ifndef VSL_TCP_TCP_METRICS_REPORT_H
+#define VSL_TCP_TCP_METRICS_REPORT_H
+
+#include "tcp_metrics.h"
+
+#include <vsl/json.h>
+#include <vsl/table.h>
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Table and JSON output of the metrics snapshots, kept apart so that the clients do not depend on libfort and
+// nlohmann json
+
+namespace vsl::tcp
+{
+
+VSL_JSON(LatencySnapshot, count, min_ns, mean_ns, p50_ns, p90_ns, p99_ns, p999_ns, max_ns)
+
+VSL_JSON(TcpMetricsSnapshot,
+         bytes_sent,
+         bytes_received,
+         frames_sent,
+         frames_received,
+         flush_count,
+         accept_count,
+         accept_rate,
+         read_latency,
+         write_latency,
+         flush_latency)
+
+namespace detail
+{
+
+inline auto format_latency(uint64_t ns) -> std::string
+{
+    return fmt::format("{:.1f}", static_cast<double>(ns) / 1000.0);
+}
+
+inline auto write_latency_row(vsl::Table& table, std::string_view name, const LatencySnapshot& latency) -> void
+{
+    table.write_ln(name,
+                   latency.count,
+                   format_latency(latency.min_ns),
+                   format_latency(latency.mean_ns),
+                   format_latency(latency.p50_ns),
+                   format_latency(latency.p90_ns),
+                   format_latency(latency.p99_ns),
+                   format_latency(latency.p999_ns),
+                   format_latency(latency.max_ns));
+}
+
+}  // namespace detail
+
+// Counters followed by the latencies (in microseconds)
+inline auto metrics_to_table(const TcpMetricsSnapshot& snapshot,
+                             vsl::TableBorderStyle style = vsl::TableBorderStyle::BASIC) -> vsl::Table
+{
+    auto table = vsl::Table{style};
+
+    table.write_header_ln("Counter", "Value");
+    table.write_ln("Bytes sent", snapshot.bytes_sent);
+    table.write_ln("Bytes received", snapshot.bytes_received);
+    table.write_ln("Frames sent", snapshot.frames_sent);
+    table.write_ln("Frames received", snapshot.frames_received);
+    table.write_ln("Flushes", snapshot.flush_count);
+    table.write_ln("Accepts", snapshot.accept_count);
+    table.write_ln("Accept rate, 1/s", fmt::format("{:.2f}", snapshot.accept_rate));
+    table.add_separator();
+
+    table.write_header_ln("Latency, us", "Count", "Min", "Mean", "p50", "p90", "p99", "p99.9", "Max");
+    detail::write_latency_row(table, "Read", snapshot.read_latency);
+    detail::write_latency_row(table, "Write", snapshot.write_latency);
+    detail::write_latency_row(table, "Flush", snapshot.flush_latency);
+
+    return table;
+}
+
+inline auto metrics_to_json(const TcpMetricsSnapshot& snapshot) -> nlohmann::json
+{
+    return nlohmann::json(snapshot);
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_METRICS_REPORT_H
@@ -0,0 +1,102 @@
+#ifndef VSL_TCP_TCP_QUEUE_H
+#define VSL_TCP_TCP_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace vsl::tcp::detail
+{
+
+// Bounded lock-free queue (D. Vyukov) for many producers and a single consumer.
+// Capacity is rounded up to a power of two.
+template<typename T>
+class MpscQueue
+{
+  public:
+    explicit MpscQueue(size_t capacity)
+        : cells_{std::make_unique<Cell[]>(std::bit_ceil(std::max(capacity, size_t{2})))},
+          mask_{std::bit_ceil(std::max(capacity, size_t{2})) - 1}
+    {
+        for (auto i = size_t{0}; i <= mask_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    auto capacity() const noexcept -> size_t
+    {
+        return mask_ + 1;
+    }
+
+    // The value is moved from only on success
+    auto try_push(T& value) -> bool
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& cell = cells_[pos & mask_];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    auto try_pop() -> std::optional<T>
+    {
+        auto& cell = cells_[dequeue_pos_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+        {
+            return std::nullopt;
+        }
+
+        auto value = std::optional<T>{std::exchange(cell.value, T{})};
+        cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return value;
+    }
+
+  private:
+    static inline constexpr auto CACHE_LINE_SIZE = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE) size_t dequeue_pos_{0};
+};
+
+}  // namespace vsl::tcp::detail
+
+#endif  // VSL_TCP_TCP_QUEUE_H
@@ -0,0 +1,102 @@
+#ifndef VSL_TCP_TCP_SENDER_H
+#define VSL_TCP_TCP_SENDER_H
+
+#include "tcp_client.h"
+#include "tcp_queue.h"
+
+#include <vsl/concepts.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+class TcpSenderError : public TcpError
+{
+    using TcpError::TcpError;
+};
+
+// Sends frames to a TcpClient from many threads without locking: producers encode frames and put them
+// into a bounded lock-free queue, a writer thread batches the queued frames into vectored socket writes.
+// The client must outlive the sender and must not be written to by other threads while the sender runs.
+class TcpSender final
+{
+  public:
+    enum class OverflowPolicy
+    {
+        BLOCK,
+        DROP,
+        THROW,
+    };
+
+    explicit TcpSender(TcpClient& client,
+                       size_t queue_capacity = DEFAULT_QUEUE_CAPACITY,
+                       OverflowPolicy overflow_policy = OverflowPolicy::BLOCK);
+
+    TcpSender(const TcpSender&) = delete;
+    TcpSender& operator=(const TcpSender&) = delete;
+
+    ~TcpSender();
+
+    // Return false if the frame was dropped (OverflowPolicy::DROP)
+    template<typename T>
+        requires vsl::numeric<T>
+    auto send(T value) -> bool;
+
+    template<vsl::numeric ItemType, typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto send_vector(const std::vector<ItemType>& vec) -> bool;
+
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    auto send_string(std::string_view str) -> bool;
+
+    template<typename T, typename Size>
+    auto send_raw(const T* buffer, Size length) -> bool;
+
+    // Sends the queued frames (every frame whose send returned true) and stops the writer thread,
+    // sends racing with stop() either get their frame sent or throw. Rethrows the exception that stopped the writer.
+    auto stop() -> void;
+
+    auto is_running() const -> bool;
+    auto queue_capacity() const -> size_t;
+    auto get_dropped_count() const -> uint64_t;
+
+  private:
+    using Frame = std::vector<std::byte>;
+
+    static inline constexpr auto DEFAULT_QUEUE_CAPACITY = size_t{1024};
+    static inline constexpr auto MAX_BATCH_SIZE = size_t{1024};
+
+    template<typename SizeType>
+    auto make_frame(size_t size, std::span<const std::byte> payload) const -> Frame;
+
+    auto push(Frame& frame) -> bool;
+    auto run_writer() -> void;
+    auto send_batch(std::vector<Frame>& batch) -> void;
+
+    TcpClient& client_;
+    OverflowPolicy overflow_policy_;
+    detail::MpscQueue<Frame> queue_;
+
+    std::atomic_bool is_running_{true};
+    std::atomic_bool stop_requested_{false};
+    std::atomic<uint32_t> push_count_{0};
+    std::atomic<uint32_t> push_epoch_{0};
+    std::atomic<uint32_t> pop_epoch_{0};
+    std::atomic<uint64_t> dropped_count_{0};
+
+    std::future<void> writer_{};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_sender_impl.h"
+
+#endif  // VSL_TCP_TCP_SENDER_H
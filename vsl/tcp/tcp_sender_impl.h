@@ -0,0 +1,203 @@
+#ifndef VSL_TCP_TCP_SENDER_IMPL_H
+#define VSL_TCP_TCP_SENDER_IMPL_H
+
+#include "tcp_byte_order.h"
+
+#include <vsl/scope_guard.h>
+#include <vsl/threading.h>
+#include <vsl/types.h>
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <utility>
+
+namespace vsl::tcp
+{
+
+inline TcpSender::TcpSender(TcpClient& client, size_t queue_capacity, OverflowPolicy overflow_policy)
+    : client_{client},
+      overflow_policy_{overflow_policy},
+      queue_{queue_capacity}
+{
+    writer_ = vsl::run_async(&TcpSender::run_writer, this);
+}
+
+inline TcpSender::~TcpSender()
+{
+    try
+    {
+        stop();
+    }
+    catch (...)
+    {
+    }
+}
+
+template<typename T>
+    requires vsl::numeric<T>
+auto TcpSender::send(T value) -> bool
+{
+    auto frame = Frame(sizeof(T));
+    detail::store(frame.data(), value, client_.byte_order_);
+    return push(frame);
+}
+
+template<vsl::numeric ItemType, typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto TcpSender::send_vector(const std::vector<ItemType>& vec) -> bool
+{
+    auto frame = make_frame<SizeType>(vec.size(), std::as_bytes(std::span{vec}));
+    if (client_.byte_order_ != std::endian::native)
+    {
+        auto payload = std::span{frame}.subspan(sizeof(typename SizeType::type));
+        detail::byteswap_items<sizeof(ItemType)>(payload.data(), payload.size());
+    }
+    return push(frame);
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+auto TcpSender::send_string(std::string_view str) -> bool
+{
+    auto frame = make_frame<SizeType>(str.size(), std::as_bytes(std::span{str}));
+    return push(frame);
+}
+
+template<typename T, typename Size>
+auto TcpSender::send_raw(const T* buffer, Size length) -> bool
+{
+    auto data_ptr = reinterpret_cast<const std::byte*>(buffer);
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+    auto frame = Frame(data_ptr, data_ptr + data_size);
+    return push(frame);
+}
+
+template<typename SizeType>
+auto TcpSender::make_frame(size_t size, std::span<const std::byte> payload) const -> Frame
+{
+    using size_type = typename SizeType::type;
+
+    auto frame = Frame(sizeof(size_type) + payload.size());
+    detail::store(frame.data(), vsl::checked_cast<size_type>(size), client_.byte_order_);
+    std::ranges::copy(payload, frame.data() + sizeof(size_type));
+    return frame;
+}
+
+inline auto TcpSender::push(Frame& frame) -> bool
+{
+    // The writer does not stop while a push that has not seen the stop request is in progress
+    push_count_.fetch_add(1);
+    VSL_SCOPE_GUARD
+    {
+        push_count_.fetch_sub(1);
+        push_epoch_.fetch_add(1, std::memory_order_release);
+        push_epoch_.notify_one();
+    };
+
+    while (true)
+    {
+        if (!is_running_.load() || stop_requested_.load())
+        {
+            throw TcpSenderError{"Failed to send", "Sender is stopped"};
+        }
+
+        auto epoch = pop_epoch_.load(std::memory_order_acquire);
+        if (queue_.try_push(frame)) break;
+
+        switch (overflow_policy_)
+        {
+        case OverflowPolicy::BLOCK:
+            pop_epoch_.wait(epoch);
+            break;
+        case OverflowPolicy::DROP:
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case OverflowPolicy::THROW:
+            throw TcpSenderError{"Failed to send", "Queue is full"};
+        }
+    }
+
+    return true;
+}
+
+inline auto TcpSender::run_writer() -> void
+{
+    // Blocked producers have to see that the writer is gone
+    VSL_SCOPE_GUARD
+    {
+        is_running_.store(false);
+        pop_epoch_.fetch_add(1, std::memory_order_release);
+        pop_epoch_.notify_all();
+    };
+
+    auto batch = std::vector<Frame>{};
+    while (true)
+    {
+        auto epoch = push_epoch_.load(std::memory_order_acquire);
+        auto is_stopping = stop_requested_.load();
+        // Counted before draining: the frames of the pushes finished by now are in the queue
+        auto is_pushing = push_count_.load() > 0;
+
+        while (batch.size() < MAX_BATCH_SIZE)
+        {
+            auto frame = queue_.try_pop();
+            if (!frame) break;
+            batch.push_back(std::move(*frame));
+        }
+
+        if (batch.empty())
+        {
+            if (is_stopping && !is_pushing) break;
+            push_epoch_.wait(epoch);
+            continue;
+        }
+
+        pop_epoch_.fetch_add(1, std::memory_order_release);
+        pop_epoch_.notify_all();
+
+        send_batch(batch);
+        batch.clear();
+    }
+}
+
+inline auto TcpSender::send_batch(std::vector<Frame>& batch) -> void
+{
+    auto buffer = GatherBuffer{};
+    for (const auto& frame : batch)
+    {
+        buffer.append(frame.data(), frame.size());
+    }
+    client_.send_gathered(buffer);
+    client_.add_metric(&TcpMetrics::frames_sent, batch.size());
+}
+
+inline auto TcpSender::stop() -> void
+{
+    if (!writer_.valid()) return;
+
+    stop_requested_.store(true);
+    push_epoch_.fetch_add(1, std::memory_order_release);
+    push_epoch_.notify_one();
+
+    writer_.get();
+}
+
+inline auto TcpSender::is_running() const -> bool
+{
+    return is_running_.load();
+}
+
+inline auto TcpSender::queue_capacity() const -> size_t
+{
+    return queue_.capacity();
+}
+
+inline auto TcpSender::get_dropped_count() const -> uint64_t
+{
+    return dropped_count_.load(std::memory_order_relaxed);
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_SENDER_IMPL_H
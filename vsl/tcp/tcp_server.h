@@ -0,0 +1,170 @@
+#ifndef VSL_TCP_TCP_SERVER_H
+#define VSL_TCP_TCP_SERVER_H
+
+#include "tcp_client.h"
+#include "tcp_epoll.h"
+#include "tcp_listener.h"
+
+#include <vsl/concepts.h>
+
+#include <Poco/Net/StreamSocket.h>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+// Single-threaded epoll event loop server (Linux only).
+// Frames use the TcpClient wire format: size prefix in the given byte order followed by the payload,
+// i.e. what TcpClient::write_string<SizeType>() sends and TcpClient::read_string<SizeType>() receives.
+// Handlers are called from the thread running run(). stop() is the only thread-safe method.
+// A failed accept (e.g. EMFILE) or an exception of a handler does not stop the server: the error is passed to
+// the error handler, without one the first error is rethrown by run() after stopping. A connection whose handler
+// has thrown is disconnected. After a failed accept the server stops accepting for ACCEPT_RETRY_DELAY,
+// as the connection stays queued.
+class TcpServer final
+{
+  public:
+    using ConnectionId = uint64_t;
+
+    class Connection final
+    {
+      public:
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        auto id() const -> ConnectionId;
+
+        auto write_string(std::string_view str) -> void;
+
+        template<typename T, typename Size>
+        auto write_raw(const T* buffer, Size length) -> void;
+
+        // Closes the connection after all pending data is sent, data written after close() is discarded
+        auto close() -> void;
+
+        auto pending_write_size() const -> size_t;
+        auto get_remote_endpoint() const -> std::pair<std::string, int>;
+
+      private:
+        friend class TcpServer;
+
+        Connection(TcpServer& server, ConnectionId id, Poco::Net::StreamSocket socket);
+
+        auto fd() const -> int;
+
+        TcpServer& server_;
+        ConnectionId id_;
+        Poco::Net::StreamSocket socket_;
+
+        std::vector<char> in_buffer_{};
+        size_t in_begin_{0};
+        size_t in_end_{0};
+
+        std::vector<char> out_buffer_{};
+        size_t out_begin_{0};
+
+        uint32_t epoll_events_{EPOLLIN};
+        bool is_closing_{false};
+        bool is_flush_scheduled_{false};
+    };
+
+    using ConnectHandler = std::function<void(Connection&)>;
+    using FrameHandler = std::function<void(Connection&, std::string_view frame)>;
+    using DisconnectHandler = std::function<void(Connection&)>;
+    // connection is nullptr for accept errors
+    using ErrorHandler = std::function<void(std::exception_ptr error, Connection* connection)>;
+
+    static inline constexpr auto ACCEPT_RETRY_DELAY = std::chrono::milliseconds{10};
+
+    template<typename SizeType = TcpClient::size64_t>
+        requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+    explicit TcpServer(TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE, SizeType = {});
+
+    TcpServer(const TcpServer&) = delete;
+    TcpServer& operator=(const TcpServer&) = delete;
+
+    auto start(int port) -> void;
+    auto start(const std::pair<std::string, int>& endpoint) -> void;
+    auto start(const std::string& ip, int port) -> void;
+    auto start(const std::string& endpoint) -> void;
+
+    // Runs the event loop until stop() is called, then closes all connections and the listening socket.
+    // Rethrows the first error (if there is no error handler).
+    auto run() -> void;
+    auto stop() -> void;
+
+    auto on_connect(ConnectHandler handler) -> void;
+    auto on_frame(FrameHandler handler) -> void;
+    auto on_disconnect(DisconnectHandler handler) -> void;
+    auto on_error(ErrorHandler handler) -> void;
+
+    auto set_max_frame_size(size_t size) -> void;
+
+    auto find_connection(ConnectionId id) -> Connection*;
+    auto connection_count() const -> size_t;
+    auto get_port() -> int;
+    auto is_listening() const -> bool;
+
+  private:
+    static inline constexpr auto LISTENER_KEY = ConnectionId{0};
+    static inline constexpr auto MAX_EVENTS = 256;
+    static inline constexpr auto READ_CHUNK_SIZE = size_t{16 * 1024};
+    static inline constexpr auto MIN_READ_SIZE = size_t{4 * 1024};
+    static inline constexpr auto MAX_IDLE_BUFFER_SIZE = size_t{1024 * 1024};
+    static inline constexpr auto DEFAULT_MAX_FRAME_SIZE = size_t{64 * 1024 * 1024};
+
+    auto register_listener() -> void;
+    auto accept_connections() -> void;
+    auto pause_accepting() -> void;
+    auto resume_accepting() -> int;
+    auto report_error(std::exception_ptr error, Connection* connection) -> void;
+    auto handle_event(ConnectionId id, uint32_t events) -> void;
+    auto receive(Connection& connection) -> bool;
+    auto dispatch_frames(Connection& connection) -> bool;
+    auto schedule_flush(Connection& connection) -> void;
+    auto flush_pending() -> void;
+    auto flush(Connection& connection) -> bool;
+    auto update_events(Connection& connection) -> void;
+    auto disconnect(Connection& connection) -> void;
+    auto close_all() -> void;
+
+    std::endian byte_order_;
+    size_t size_prefix_size_;
+    size_t max_frame_size_{DEFAULT_MAX_FRAME_SIZE};
+
+    TcpListener listener_{};
+    detail::Epoll epoll_{};
+    std::atomic_bool stop_requested_{false};
+    std::optional<std::chrono::steady_clock::time_point> accept_resume_time_{};
+
+    std::unordered_map<ConnectionId, std::unique_ptr<Connection>> connections_{};
+    std::vector<ConnectionId> pending_flush_{};
+    std::vector<ConnectionId> flushing_{};
+    ConnectionId next_connection_id_{LISTENER_KEY + 1};
+
+    ConnectHandler connect_handler_{};
+    FrameHandler frame_handler_{};
+    DisconnectHandler disconnect_handler_{};
+    ErrorHandler error_handler_{};
+    std::exception_ptr first_error_{};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_server_impl.h"
+
+#endif  // VSL_TCP_TCP_SERVER_H
@@ -0,0 +1,512 @@
+#ifndef VSL_TCP_TCP_SERVER_IMPL_H
+#define VSL_TCP_TCP_SERVER_IMPL_H
+
+#include "tcp_byte_order.h"
+
+#include <vsl/concepts.h>
+#include <vsl/scope_guard.h>
+#include <vsl/types.h>
+
+#include <Poco/Net/StreamSocket.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace vsl::tcp
+{
+
+inline TcpServer::Connection::Connection(TcpServer& server, ConnectionId id, Poco::Net::StreamSocket socket)
+    : server_{server},
+      id_{id},
+      socket_{std::move(socket)}
+{}
+
+inline auto TcpServer::Connection::id() const -> ConnectionId
+{
+    return id_;
+}
+
+inline auto TcpServer::Connection::write_string(std::string_view str) -> void
+{
+    auto size_prefix = std::array<char, sizeof(uint64_t)>{};
+    if (server_.size_prefix_size_ == sizeof(uint64_t))
+    {
+        detail::store(size_prefix.data(), static_cast<uint64_t>(str.size()), server_.byte_order_);
+    }
+    else
+    {
+        detail::store(size_prefix.data(), vsl::checked_cast<uint32_t>(str.size()), server_.byte_order_);
+    }
+
+    write_raw(size_prefix.data(), server_.size_prefix_size_);
+    write_raw(str.data(), str.size());
+}
+
+template<typename T, typename Size>
+auto TcpServer::Connection::write_raw(const T* buffer, Size length) -> void
+{
+    if (is_closing_) return;
+
+    if (out_begin_ > 0 && out_begin_ * 2 >= out_buffer_.size())
+    {
+        out_buffer_.erase(out_buffer_.begin(), out_buffer_.begin() + vsl::as_signed(out_begin_));
+        out_begin_ = 0;
+    }
+
+    auto data_ptr = reinterpret_cast<const char*>(buffer);
+    auto data_size = vsl::checked_cast<size_t>(length) * sizeof(T);
+    out_buffer_.insert(out_buffer_.end(), data_ptr, data_ptr + data_size);
+
+    server_.schedule_flush(*this);
+}
+
+inline auto TcpServer::Connection::close() -> void
+{
+    is_closing_ = true;
+    server_.schedule_flush(*this);
+}
+
+inline auto TcpServer::Connection::pending_write_size() const -> size_t
+{
+    return out_buffer_.size() - out_begin_;
+}
+
+inline auto TcpServer::Connection::get_remote_endpoint() const -> std::pair<std::string, int>
+{
+    auto socket_addr = socket_.peerAddress();
+    return std::pair{socket_addr.host().toString(), socket_addr.port()};
+}
+
+inline auto TcpServer::Connection::fd() const -> int
+{
+    return socket_.impl()->sockfd();
+}
+
+template<typename SizeType>
+    requires vsl::one_of_type<SizeType, TcpClient::size64_t, TcpClient::size32_t>
+TcpServer::TcpServer(TcpClient::ByteOrder byte_order, SizeType)
+    : byte_order_{detail::to_endian(byte_order)},
+      size_prefix_size_{sizeof(typename SizeType::type)}
+{}
+
+inline auto TcpServer::start(int port) -> void
+{
+    listener_.start(port);
+    register_listener();
+}
+
+inline auto TcpServer::start(const std::pair<std::string, int>& endpoint) -> void
+{
+    listener_.start(endpoint);
+    register_listener();
+}
+
+inline auto TcpServer::start(const std::string& ip, int port) -> void
+{
+    listener_.start(ip, port);
+    register_listener();
+}
+
+inline auto TcpServer::start(const std::string& endpoint) -> void
+{
+    listener_.start(endpoint);
+    register_listener();
+}
+
+inline auto TcpServer::register_listener() -> void
+{
+    auto& server_socket = listener_.server_socket_;
+    server_socket.setBlocking(false);
+    epoll_.add(server_socket.impl()->sockfd(), EPOLLIN, LISTENER_KEY);
+}
+
+inline auto TcpServer::run() -> void
+{
+    auto events = std::array<epoll_event, MAX_EVENTS>{};
+
+    while (!stop_requested_.load())
+    {
+        for (const auto& event : epoll_.wait(events, resume_accepting()))
+        {
+            handle_event(event.data.u64, event.events);
+        }
+        flush_pending();
+    }
+
+    close_all();
+    accept_resume_time_.reset();
+    stop_requested_.store(false);
+
+    if (auto error = std::exchange(first_error_, nullptr)) std::rethrow_exception(error);
+}
+
+inline auto TcpServer::stop() -> void
+{
+    stop_requested_.store(true);
+    epoll_.wakeup();
+}
+
+inline auto TcpServer::on_connect(ConnectHandler handler) -> void
+{
+    connect_handler_ = std::move(handler);
+}
+
+inline auto TcpServer::on_frame(FrameHandler handler) -> void
+{
+    frame_handler_ = std::move(handler);
+}
+
+inline auto TcpServer::on_disconnect(DisconnectHandler handler) -> void
+{
+    disconnect_handler_ = std::move(handler);
+}
+
+inline auto TcpServer::on_error(ErrorHandler handler) -> void
+{
+    error_handler_ = std::move(handler);
+}
+
+inline auto TcpServer::set_max_frame_size(size_t size) -> void
+{
+    max_frame_size_ = size;
+}
+
+inline auto TcpServer::find_connection(ConnectionId id) -> Connection*
+{
+    auto it = connections_.find(id);
+    return (it != connections_.end()) ? it->second.get() : nullptr;
+}
+
+inline auto TcpServer::connection_count() const -> size_t
+{
+    return connections_.size();
+}
+
+inline auto TcpServer::get_port() -> int
+{
+    return listener_.get_port();
+}
+
+inline auto TcpServer::is_listening() const -> bool
+{
+    return listener_.is_listening();
+}
+
+inline auto TcpServer::accept_connections() -> void
+{
+    const auto listener_fd = listener_.server_socket_.impl()->sockfd();
+
+    while (true)
+    {
+        auto fd = accept4(listener_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+
+            try
+            {
+                detail::throw_system_error("Failed to accept client");
+            }
+            catch (...)
+            {
+                report_error(std::current_exception(), nullptr);
+            }
+            pause_accepting();
+            return;
+        }
+
+        auto id = next_connection_id_++;
+        auto connection = std::unique_ptr<Connection>{};
+        try
+        {
+            auto socket = detail::wrap_socket_fd(fd);
+            socket.setNoDelay(true);
+
+            connection.reset(new Connection{*this, id, std::move(socket)});
+            epoll_.add(fd, connection->epoll_events_, id);
+        }
+        catch (...)
+        {
+            // The fd is closed by the connection or socket destructor, or by wrap_socket_fd()
+            report_error(std::current_exception(), nullptr);
+            continue;
+        }
+
+        auto& added = *connections_.emplace(id, std::move(connection)).first->second;
+        if (!connect_handler_) continue;
+
+        try
+        {
+            connect_handler_(added);
+        }
+        catch (...)
+        {
+            report_error(std::current_exception(), &added);
+            disconnect(added);
+        }
+    }
+}
+
+// The listening socket stays readable while the connection is queued, so it is not watched until the delay passes
+inline auto TcpServer::pause_accepting() -> void
+{
+    epoll_.modify(listener_.server_socket_.impl()->sockfd(), 0, LISTENER_KEY);
+    accept_resume_time_ = std::chrono::steady_clock::now() + ACCEPT_RETRY_DELAY;
+}
+
+// Returns the epoll wait timeout: the time left until accepting is resumed or infinite
+inline auto TcpServer::resume_accepting() -> int
+{
+    if (!accept_resume_time_) return -1;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < *accept_resume_time_)
+    {
+        auto time_left = std::chrono::ceil<std::chrono::milliseconds>(*accept_resume_time_ - now);
+        return static_cast<int>(time_left.count());
+    }
+
+    epoll_.modify(listener_.server_socket_.impl()->sockfd(), EPOLLIN, LISTENER_KEY);
+    accept_resume_time_.reset();
+    return -1;
+}
+
+inline auto TcpServer::report_error(std::exception_ptr error, Connection* connection) -> void
+{
+    if (error_handler_)
+    {
+        error_handler_(error, connection);
+        return;
+    }
+
+    if (!first_error_) first_error_ = error;
+}
+
+inline auto TcpServer::handle_event(ConnectionId id, uint32_t events) -> void
+{
+    if (id == LISTENER_KEY)
+    {
+        if (!accept_resume_time_) accept_connections();
+        return;
+    }
+
+    auto* connection = find_connection(id);
+    if (!connection) return;
+
+    // Errors and hangups are reported by recv()
+    if ((events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0 && !receive(*connection))
+    {
+        disconnect(*connection);
+        return;
+    }
+
+    if ((events & EPOLLOUT) != 0 && !flush(*connection))
+    {
+        disconnect(*connection);
+    }
+}
+
+inline auto TcpServer::receive(Connection& connection) -> bool
+{
+    auto& buffer = connection.in_buffer_;
+
+    while (!connection.is_closing_)
+    {
+        if (buffer.size() - connection.in_end_ < MIN_READ_SIZE)
+        {
+            if (connection.in_begin_ > 0)
+            {
+                auto data_size = connection.in_end_ - connection.in_begin_;
+                std::memmove(buffer.data(), buffer.data() + connection.in_begin_, data_size);
+                connection.in_end_ = data_size;
+                connection.in_begin_ = 0;
+            }
+
+            if (buffer.size() - connection.in_end_ < MIN_READ_SIZE)
+            {
+                buffer.resize(std::max(buffer.size() * 2, connection.in_end_ + READ_CHUNK_SIZE));
+            }
+        }
+
+        auto free_size = buffer.size() - connection.in_end_;
+        auto received_count = ::recv(connection.fd(), buffer.data() + connection.in_end_, free_size, 0);
+        if (received_count == 0) return false;
+        if (received_count < 0)
+        {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        connection.in_end_ += vsl::as_unsigned(received_count);
+        if (!dispatch_frames(connection)) return false;
+
+        // Short read: the socket is drained, level-triggered epoll reports the rest
+        if (vsl::as_unsigned(received_count) < free_size) break;
+    }
+
+    return true;
+}
+
+inline auto TcpServer::dispatch_frames(Connection& connection) -> bool
+{
+    auto& buffer = connection.in_buffer_;
+
+    while (!connection.is_closing_)
+    {
+        auto available = connection.in_end_ - connection.in_begin_;
+        if (available < size_prefix_size_) break;
+
+        const auto* data = buffer.data() + connection.in_begin_;
+        auto frame_size = (size_prefix_size_ == sizeof(uint64_t)) ? detail::load<uint64_t>(data, byte_order_)
+                                                                  : detail::load<uint32_t>(data, byte_order_);
+        if (frame_size > max_frame_size_) return false;
+
+        auto payload_size = static_cast<size_t>(frame_size);
+        if (available - size_prefix_size_ < payload_size) break;
+
+        connection.in_begin_ += size_prefix_size_ + payload_size;
+        if (!frame_handler_) continue;
+
+        try
+        {
+            frame_handler_(connection, std::string_view{data + size_prefix_size_, payload_size});
+        }
+        catch (...)
+        {
+            report_error(std::current_exception(), &connection);
+            return false;
+        }
+    }
+
+    if (connection.in_begin_ == connection.in_end_)
+    {
+        connection.in_begin_ = 0;
+        connection.in_end_ = 0;
+
+        if (buffer.size() > MAX_IDLE_BUFFER_SIZE)
+        {
+            buffer.clear();
+            buffer.shrink_to_fit();
+        }
+    }
+
+    return true;
+}
+
+inline auto TcpServer::schedule_flush(Connection& connection) -> void
+{
+    if (connection.is_flush_scheduled_) return;
+
+    connection.is_flush_scheduled_ = true;
+    pending_flush_.push_back(connection.id_);
+}
+
+inline auto TcpServer::flush_pending() -> void
+{
+    // Disconnect handlers may schedule flushes of other connections
+    while (!pending_flush_.empty())
+    {
+        std::swap(pending_flush_, flushing_);
+        for (auto id : flushing_)
+        {
+            auto* connection = find_connection(id);
+            if (!connection) continue;
+
+            connection->is_flush_scheduled_ = false;
+            if (!flush(*connection)) disconnect(*connection);
+        }
+        flushing_.clear();
+    }
+}
+
+// Returns false if the connection is lost or closed
+inline auto TcpServer::flush(Connection& connection) -> bool
+{
+    auto& buffer = connection.out_buffer_;
+
+    while (connection.out_begin_ < buffer.size())
+    {
+        auto data_size = buffer.size() - connection.out_begin_;
+        auto sent_count = ::send(connection.fd(), buffer.data() + connection.out_begin_, data_size, MSG_NOSIGNAL);
+        if (sent_count < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        connection.out_begin_ += vsl::as_unsigned(sent_count);
+    }
+
+    if (connection.out_begin_ == buffer.size())
+    {
+        if (connection.is_closing_) return false;
+
+        buffer.clear();
+        connection.out_begin_ = 0;
+    }
+
+    update_events(connection);
+    return true;
+}
+
+// Closing connections are not read anymore, pending data is watched for writability
+inline auto TcpServer::update_events(Connection& connection) -> void
+{
+    auto events = uint32_t{0};
+    if (!connection.is_closing_) events |= EPOLLIN;
+    if (connection.pending_write_size() > 0) events |= EPOLLOUT;
+
+    if (events == connection.epoll_events_) return;
+
+    epoll_.modify(connection.fd(), events, connection.id_);
+    connection.epoll_events_ = events;
+}
+
+inline auto TcpServer::disconnect(Connection& connection) -> void
+{
+    VSL_SCOPE_GUARD
+    {
+        epoll_.remove(connection.fd());
+        connections_.erase(connection.id_);
+    };
+
+    if (!disconnect_handler_) return;
+
+    try
+    {
+        disconnect_handler_(connection);
+    }
+    catch (...)
+    {
+        report_error(std::current_exception(), &connection);
+    }
+}
+
+inline auto TcpServer::close_all() -> void
+{
+    while (!connections_.empty())
+    {
+        disconnect(*connections_.begin()->second);
+    }
+    pending_flush_.clear();
+
+    if (listener_.is_listening()) listener_.stop();
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_SERVER_IMPL_H
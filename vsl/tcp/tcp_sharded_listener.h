@@ -0,0 +1,103 @@
+#ifndef VSL_TCP_TCP_SHARDED_LISTENER_H
+#define VSL_TCP_TCP_SHARDED_LISTENER_H
+
+#include "tcp_client.h"
+#include "tcp_listener.h"
+
+#include <vsl/os.h>
+
+#if !defined(VSL_LINUX_OS)
+#error TcpShardedListener is supported on Linux only
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+// N listening sockets bound to the same endpoint with SO_REUSEPORT, each served by its own thread.
+// The kernel spreads incoming connections across the shards.
+// The accept and error handlers are called from the shard threads.
+// A failed accept (e.g. EMFILE) or an exception of the accept handler does not stop the shard: the error is passed
+// to the error handler, without one the first error is rethrown by stop(). After a failed accept the shard waits
+// ACCEPT_RETRY_DELAY before retrying, as the connection stays queued.
+class TcpShardedListener final
+{
+  public:
+    using AcceptHandler = std::function<void(TcpClient client, int shard_index)>;
+    using ErrorHandler = std::function<void(std::exception_ptr error, int shard_index)>;
+
+    static inline constexpr auto ACCEPT_RETRY_DELAY = std::chrono::milliseconds{10};
+
+    explicit TcpShardedListener(int shard_count, TcpClient::ByteOrder byte_order = TcpClient::ByteOrder::NATIVE);
+
+    TcpShardedListener(const TcpShardedListener&) = delete;
+    TcpShardedListener& operator=(const TcpShardedListener&) = delete;
+
+    ~TcpShardedListener();
+
+    auto start(int port, AcceptHandler handler) -> void;
+    auto start(const std::pair<std::string, int>& endpoint, AcceptHandler handler) -> void;
+    auto start(const std::string& ip, int port, AcceptHandler handler) -> void;
+    auto start(const std::string& endpoint, AcceptHandler handler) -> void;
+
+    // Accepts connections already queued in every shard, then closes the sockets.
+    // Rethrows the first exception raised by a shard thread (if there is no error handler).
+    auto stop() -> void;
+
+    auto on_error(ErrorHandler handler) -> void;
+
+    // Shard i thread is pinned to cpus[i % cpus.size()], empty (default) means no pinning.
+    // Must be called before start(), a failed pinning is reported as an error and the shard runs unpinned.
+    auto set_shard_cpus(std::vector<int> cpus) -> void;
+
+    auto shard_count() const -> int;
+    auto get_accept_count(int shard_index) const -> uint64_t;
+    auto get_accept_counts() const -> std::vector<uint64_t>;
+
+    auto get_port() -> int;
+    auto is_listening() const -> bool;
+
+  private:
+    struct Shard
+    {
+        TcpListener listener{};
+        std::atomic<uint64_t> accept_count{0};
+        std::future<void> worker{};
+    };
+
+    auto start_shards(auto start_first_shard, AcceptHandler handler) -> void;
+    auto run_shard(int shard_index) -> void;
+    auto pin_shard(int shard_index) -> void;
+    auto accept_client(int shard_index) -> bool;
+    auto report_error(std::exception_ptr error, int shard_index) -> void;
+    auto stop_workers() -> void;
+
+    TcpClient::ByteOrder byte_order_;
+    std::vector<std::unique_ptr<Shard>> shards_{};
+    AcceptHandler handler_{};
+    ErrorHandler error_handler_{};
+    std::vector<int> shard_cpus_{};
+
+    std::mutex error_mutex_{};
+    std::exception_ptr first_error_{};
+
+    int stop_fd_{-1};
+    bool is_listening_{false};
+};
+
+}  // namespace vsl::tcp
+
+#include "tcp_sharded_listener_impl.h"
+
+#endif  // VSL_TCP_TCP_SHARDED_LISTENER_H
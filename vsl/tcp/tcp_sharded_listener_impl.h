@@ -0,0 +1,282 @@
+#ifndef VSL_TCP_TCP_SHARDED_LISTENER_IMPL_H
+#define VSL_TCP_TCP_SHARDED_LISTENER_IMPL_H
+
+#include <vsl/threading.h>
+#include <vsl/types.h>
+
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vsl::tcp
+{
+
+inline TcpShardedListener::TcpShardedListener(int shard_count, TcpClient::ByteOrder byte_order)
+    : byte_order_{byte_order}
+{
+    if (shard_count <= 0)
+    {
+        throw TcpListenerError{"Invalid shard count", std::to_string(shard_count)};
+    }
+
+    for (auto i = 0; i < shard_count; ++i)
+    {
+        auto& shard = shards_.emplace_back(std::make_unique<Shard>());
+        shard->listener.set_reuse_port(true);
+    }
+
+    stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stop_fd_ < 0) detail::throw_system_error("Failed to create eventfd");
+}
+
+inline TcpShardedListener::~TcpShardedListener()
+{
+    stop_workers();
+    ::close(stop_fd_);
+}
+
+inline auto TcpShardedListener::start(int port, AcceptHandler handler) -> void
+{
+    start_shards([&](TcpListener& listener) { listener.start(port); }, std::move(handler));
+}
+
+inline auto TcpShardedListener::start(const std::pair<std::string, int>& endpoint, AcceptHandler handler) -> void
+{
+    start_shards([&](TcpListener& listener) { listener.start(endpoint); }, std::move(handler));
+}
+
+inline auto TcpShardedListener::start(const std::string& ip, int port, AcceptHandler handler) -> void
+{
+    start_shards([&](TcpListener& listener) { listener.start(ip, port); }, std::move(handler));
+}
+
+inline auto TcpShardedListener::start(const std::string& endpoint, AcceptHandler handler) -> void
+{
+    start_shards([&](TcpListener& listener) { listener.start(endpoint); }, std::move(handler));
+}
+
+inline auto TcpShardedListener::start_shards(auto start_first_shard, AcceptHandler handler) -> void
+{
+    if (is_listening_)
+    {
+        throw TcpListenerError{"Failed to start listening", "Already listening"};
+    }
+
+    // The first shard resolves the endpoint (e.g. port 0), the rest bind exactly the same one
+    start_first_shard(shards_.front()->listener);
+    try
+    {
+        auto endpoint = shards_.front()->listener.get_local_endpoint();
+        for (auto& shard : shards_ | std::views::drop(1))
+        {
+            shard->listener.start(endpoint);
+        }
+    }
+    catch (...)
+    {
+        for (auto& shard : shards_)
+        {
+            if (shard->listener.is_listening()) shard->listener.stop();
+        }
+        throw;
+    }
+
+    auto value = uint64_t{};
+    [[maybe_unused]] auto rc = ::read(stop_fd_, &value, sizeof(value));
+
+    handler_ = std::move(handler);
+    first_error_ = nullptr;
+    for (auto i = 0; i < shard_count(); ++i)
+    {
+        auto& shard = *shards_[vsl::as_unsigned(i)];
+        shard.accept_count.store(0);
+        shard.worker = vsl::run_async(&TcpShardedListener::run_shard, this, i);
+    }
+
+    is_listening_ = true;
+}
+
+inline auto TcpShardedListener::stop() -> void
+{
+    stop_workers();
+
+    auto error = std::exception_ptr{};
+    for (auto& shard : shards_)
+    {
+        try
+        {
+            if (shard->worker.valid()) shard->worker.get();
+        }
+        catch (...)
+        {
+            if (!error) error = std::current_exception();
+        }
+
+        if (shard->listener.is_listening()) shard->listener.stop();
+    }
+
+    is_listening_ = false;
+
+    if (!error) error = std::exchange(first_error_, nullptr);
+    if (error) std::rethrow_exception(error);
+}
+
+inline auto TcpShardedListener::on_error(ErrorHandler handler) -> void
+{
+    error_handler_ = std::move(handler);
+}
+
+inline auto TcpShardedListener::set_shard_cpus(std::vector<int> cpus) -> void
+{
+    if (is_listening_)
+    {
+        throw TcpListenerError{"Failed to set shard CPUs", "Already listening"};
+    }
+    shard_cpus_ = std::move(cpus);
+}
+
+inline auto TcpShardedListener::stop_workers() -> void
+{
+    auto value = uint64_t{1};
+    [[maybe_unused]] auto rc = ::write(stop_fd_, &value, sizeof(value));
+
+    for (auto& shard : shards_)
+    {
+        if (shard->worker.valid()) shard->worker.wait();
+    }
+}
+
+inline auto TcpShardedListener::run_shard(int shard_index) -> void
+{
+    pin_shard(shard_index);
+
+    auto& listener = shards_[vsl::as_unsigned(shard_index)]->listener;
+    auto fds = std::array{
+        pollfd{.fd = listener.server_socket_.impl()->sockfd(), .events = POLLIN, .revents = 0},
+        pollfd{.fd = stop_fd_, .events = POLLIN, .revents = 0},
+    };
+
+    while (fds[1].revents == 0)
+    {
+        if (::poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            detail::throw_system_error("Failed to wait for clients");
+        }
+
+        if ((fds[0].revents & POLLIN) != 0 && !accept_client(shard_index))
+        {
+            // Interrupted by stop() as well
+            ::poll(&fds[1], 1, static_cast<int>(ACCEPT_RETRY_DELAY.count()));
+        }
+    }
+
+    // Drain: connections already queued by the kernel would be reset on close
+    while (::poll(fds.data(), 1, 0) > 0 && (fds[0].revents & POLLIN) != 0 && accept_client(shard_index))
+    {
+    }
+}
+
+inline auto TcpShardedListener::pin_shard(int shard_index) -> void
+{
+    if (shard_cpus_.empty()) return;
+
+    auto cpu_set = cpu_set_t{};
+    CPU_ZERO(&cpu_set);
+    CPU_SET(vsl::as_unsigned(shard_cpus_[vsl::as_unsigned(shard_index) % shard_cpus_.size()]), &cpu_set);
+
+    auto error_code = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (error_code != 0)
+    {
+        try
+        {
+            detail::throw_system_error("Failed to pin shard thread", error_code);
+        }
+        catch (const TcpError&)
+        {
+            report_error(std::current_exception(), shard_index);
+        }
+    }
+}
+
+// Returns false if accepting failed
+inline auto TcpShardedListener::accept_client(int shard_index) -> bool
+{
+    auto& shard = *shards_[vsl::as_unsigned(shard_index)];
+
+    // The client is constructed by accept_client() in place, a handler error is reported the same way
+    auto is_accepted = false;
+    try
+    {
+        auto client = shard.listener.accept_client(byte_order_);
+        is_accepted = true;
+        shard.accept_count.fetch_add(1, std::memory_order_relaxed);
+
+        handler_(std::move(client), shard_index);
+    }
+    catch (...)
+    {
+        report_error(std::current_exception(), shard_index);
+    }
+    return is_accepted;
+}
+
+inline auto TcpShardedListener::report_error(std::exception_ptr error, int shard_index) -> void
+{
+    if (error_handler_)
+    {
+        error_handler_(error, shard_index);
+        return;
+    }
+
+    auto _ = std::scoped_lock(error_mutex_);
+    if (!first_error_) first_error_ = error;
+}
+
+inline auto TcpShardedListener::shard_count() const -> int
+{
+    return vsl::checked_cast<int>(shards_.size());
+}
+
+inline auto TcpShardedListener::get_accept_count(int shard_index) const -> uint64_t
+{
+    return shards_.at(vsl::as_unsigned(shard_index))->accept_count.load(std::memory_order_relaxed);
+}
+
+inline auto TcpShardedListener::get_accept_counts() const -> std::vector<uint64_t>
+{
+    auto counts = std::vector<uint64_t>{};
+    counts.reserve(shards_.size());
+    for (const auto& shard : shards_)
+    {
+        counts.push_back(shard->accept_count.load(std::memory_order_relaxed));
+    }
+    return counts;
+}
+
+inline auto TcpShardedListener::get_port() -> int
+{
+    return shards_.front()->listener.get_port();
+}
+
+inline auto TcpShardedListener::is_listening() const -> bool
+{
+    return is_listening_;
+}
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_SHARDED_LISTENER_IMPL_H
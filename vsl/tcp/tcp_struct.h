@@ -0,0 +1,140 @@
+#ifndef VSL_TCP_TCP_STRUCT_H
+#define VSL_TCP_TCP_STRUCT_H
+
+#include <vsl/concepts.h>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Field lists for TcpClient::read_struct() / TcpClient::write_struct():
+//   VSL_TCP_STRUCT(Type, field1, field2, ...)         - at namespace scope of Type
+//   VSL_TCP_STRUCT_INLINE(Type, field1, field2, ...)  - inside Type (private fields)
+// Supported fields: numeric, enum, std::string, std::vector, std::array and other declared structs.
+// A struct is written as one block (if the byte order is native) when it is trivially copyable, standard layout
+// and the listed fixed size fields cover all its bytes in the declaration order (no padding, no reordering),
+// so the block is the same as the fields written one by one. Grouping the fixed size fields into a nested struct
+// gets them written at once. bool fields are read one by one, as only 0 and 1 are valid bool bytes.
+
+#define VSL_DETAIL_TCP_PARENS ()
+
+#define VSL_DETAIL_TCP_EXPAND(...) VSL_DETAIL_TCP_EXPAND4(VSL_DETAIL_TCP_EXPAND4(VSL_DETAIL_TCP_EXPAND4(__VA_ARGS__)))
+#define VSL_DETAIL_TCP_EXPAND4(...) VSL_DETAIL_TCP_EXPAND3(VSL_DETAIL_TCP_EXPAND3(VSL_DETAIL_TCP_EXPAND3(__VA_ARGS__)))
+#define VSL_DETAIL_TCP_EXPAND3(...) VSL_DETAIL_TCP_EXPAND2(VSL_DETAIL_TCP_EXPAND2(VSL_DETAIL_TCP_EXPAND2(__VA_ARGS__)))
+#define VSL_DETAIL_TCP_EXPAND2(...) VSL_DETAIL_TCP_EXPAND1(VSL_DETAIL_TCP_EXPAND1(VSL_DETAIL_TCP_EXPAND1(__VA_ARGS__)))
+#define VSL_DETAIL_TCP_EXPAND1(...) __VA_ARGS__
+
+#define VSL_DETAIL_TCP_FOR_EACH(macro, ...) \
+    __VA_OPT__(VSL_DETAIL_TCP_EXPAND(VSL_DETAIL_TCP_FOR_EACH_HELPER(macro, __VA_ARGS__)))
+#define VSL_DETAIL_TCP_FOR_EACH_HELPER(macro, v1, ...) \
+    macro(v1) __VA_OPT__(VSL_DETAIL_TCP_FOR_EACH_AGAIN VSL_DETAIL_TCP_PARENS(macro, __VA_ARGS__))
+#define VSL_DETAIL_TCP_FOR_EACH_AGAIN() VSL_DETAIL_TCP_FOR_EACH_HELPER
+
+#define VSL_DETAIL_TCP_VISIT_FIELD(v1) vsl_tcp_visitor(vsl_tcp_obj.v1);
+#define VSL_DETAIL_TCP_FIELD_SIZE(v1) +sizeof(vsl_tcp_type::v1)
+#define VSL_DETAIL_TCP_FIELD_SIZE_ITEM(v1) sizeof(vsl_tcp_type::v1),
+#define VSL_DETAIL_TCP_FIELD_OFFSET(v1) offsetof(vsl_tcp_type, v1),
+#define VSL_DETAIL_TCP_FIELD_IS_FLAT(v1) &&vsl::tcp::detail::is_flat<decltype(vsl_tcp_type::v1)>()
+
+#define VSL_DETAIL_TCP_STRUCT(Specifier, Type, ...)                                                             \
+    template<typename Self, typename Visitor>                                                                   \
+        requires std::same_as<std::remove_const_t<Self>, Type>                                                  \
+    Specifier void vsl_tcp_visit_fields(Self& vsl_tcp_obj, Visitor&& vsl_tcp_visitor)                           \
+    {                                                                                                           \
+        VSL_DETAIL_TCP_FOR_EACH(VSL_DETAIL_TCP_VISIT_FIELD, __VA_ARGS__)                                        \
+    }                                                                                                           \
+    template<typename vsl_tcp_type>                                                                             \
+        requires std::same_as<vsl_tcp_type, Type>                                                               \
+    Specifier constexpr bool vsl_tcp_is_flat(const vsl_tcp_type*)                                               \
+    {                                                                                                           \
+        if constexpr (!std::is_trivially_copyable_v<vsl_tcp_type> || !std::is_standard_layout_v<vsl_tcp_type>)  \
+        {                                                                                                       \
+            return false;                                                                                       \
+        }                                                                                                       \
+        else                                                                                                    \
+        {                                                                                                       \
+            constexpr auto size = size_t{0} VSL_DETAIL_TCP_FOR_EACH(VSL_DETAIL_TCP_FIELD_SIZE, __VA_ARGS__);    \
+            constexpr auto sizes =                                                                              \
+                std::array{VSL_DETAIL_TCP_FOR_EACH(VSL_DETAIL_TCP_FIELD_SIZE_ITEM, __VA_ARGS__)};               \
+            constexpr auto offsets =                                                                            \
+                std::array{VSL_DETAIL_TCP_FOR_EACH(VSL_DETAIL_TCP_FIELD_OFFSET, __VA_ARGS__)};                  \
+            return size == sizeof(vsl_tcp_type) && vsl::tcp::detail::is_contiguous(offsets, sizes)              \
+                   && (true VSL_DETAIL_TCP_FOR_EACH(VSL_DETAIL_TCP_FIELD_IS_FLAT, __VA_ARGS__));                \
+        }                                                                                                       \
+    }
+
+#define VSL_TCP_STRUCT(Type, ...) VSL_DETAIL_TCP_STRUCT(inline, Type, __VA_ARGS__)
+#define VSL_TCP_STRUCT_INLINE(Type, ...) VSL_DETAIL_TCP_STRUCT(friend, Type, __VA_ARGS__)
+
+namespace vsl::tcp
+{
+
+template<typename T>
+concept tcp_struct = requires(T& obj) {
+    vsl_tcp_visit_fields(obj, [](auto&) {});
+    vsl_tcp_is_flat(static_cast<const T*>(nullptr));
+};
+
+namespace detail
+{
+
+template<typename T>
+inline constexpr auto is_std_vector = false;
+
+template<typename T, typename Allocator>
+inline constexpr auto is_std_vector<std::vector<T, Allocator>> = true;
+
+template<typename T>
+inline constexpr auto is_std_array = false;
+
+template<typename T, size_t N>
+inline constexpr auto is_std_array<std::array<T, N>> = true;
+
+// Fields laid out one after another from the struct start, in the listed order
+template<size_t N>
+constexpr auto is_contiguous(const std::array<size_t, N>& offsets, const std::array<size_t, N>& sizes) -> bool
+{
+    auto expected_offset = size_t{0};
+    for (auto i = size_t{0}; i < N; ++i)
+    {
+        if (offsets[i] != expected_offset) return false;
+        expected_offset += sizes[i];
+    }
+    return true;
+}
+
+// Fixed size value whose in-memory bytes are its wire format (in the native byte order).
+// Not bool: a raw read would accept byte values other than 0 and 1.
+template<typename T>
+constexpr auto is_flat() -> bool
+{
+    if constexpr (std::same_as<T, bool>)
+    {
+        return false;
+    }
+    else if constexpr (vsl::numeric<T> || std::is_enum_v<T>)
+    {
+        return true;
+    }
+    else if constexpr (is_std_array<T>)
+    {
+        using item_type = typename T::value_type;
+        return is_flat<item_type>() && sizeof(T) == sizeof(item_type) * std::tuple_size_v<T>;
+    }
+    else if constexpr (tcp_struct<T>)
+    {
+        return vsl_tcp_is_flat(static_cast<const T*>(nullptr));
+    }
+    else
+    {
+        return false;
+    }
+}
+
+}  // namespace detail
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_STRUCT_H
@@ -0,0 +1,187 @@
+#ifndef VSL_TCP_TCP_TASK_H
+#define VSL_TCP_TCP_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace vsl::tcp
+{
+
+template<typename T = void>
+class Task;
+
+namespace detail
+{
+
+class TaskPromiseBase
+{
+  public:
+    struct FinalAwaiter
+    {
+        auto await_ready() const noexcept -> bool
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<>
+        {
+            return handle.promise().continuation_;
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    auto initial_suspend() noexcept -> std::suspend_always
+    {
+        return {};
+    }
+
+    auto final_suspend() noexcept -> FinalAwaiter
+    {
+        return {};
+    }
+
+    auto unhandled_exception() noexcept -> void
+    {
+        exception_ = std::current_exception();
+    }
+
+    auto set_continuation(std::coroutine_handle<> continuation) noexcept -> void
+    {
+        continuation_ = continuation;
+    }
+
+  protected:
+    auto rethrow_if_failed() const -> void
+    {
+        if (exception_) std::rethrow_exception(exception_);
+    }
+
+  private:
+    std::coroutine_handle<> continuation_{std::noop_coroutine()};
+    std::exception_ptr exception_{};
+};
+
+template<typename T>
+class TaskPromise final : public TaskPromiseBase
+{
+  public:
+    auto get_return_object() noexcept -> Task<T>;
+
+    template<typename U>
+    auto return_value(U&& value) -> void
+    {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    auto result() -> T
+    {
+        rethrow_if_failed();
+        return std::move(*value_);
+    }
+
+  private:
+    std::optional<T> value_{};
+};
+
+template<>
+class TaskPromise<void> final : public TaskPromiseBase
+{
+  public:
+    auto get_return_object() noexcept -> Task<void>;
+
+    auto return_void() noexcept -> void {}
+
+    auto result() -> void
+    {
+        rethrow_if_failed();
+    }
+};
+
+}  // namespace detail
+
+// Lazily started coroutine, resumes its awaiter on completion (symmetric transfer)
+template<typename T>
+class [[nodiscard]] Task final
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_{handle}
+    {}
+
+    Task(Task&& other) noexcept
+        : handle_{std::exchange(other.handle_, nullptr)}
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            auto await_ready() const noexcept -> bool
+            {
+                return false;
+            }
+
+            auto await_suspend(std::coroutine_handle<> awaiter) noexcept -> std::coroutine_handle<>
+            {
+                handle.promise().set_continuation(awaiter);
+                return handle;
+            }
+
+            auto await_resume() -> T
+            {
+                return handle.promise().result();
+            }
+        };
+
+        return Awaiter{handle_};
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail
+{
+
+template<typename T>
+auto TaskPromise<T>::get_return_object() noexcept -> Task<T>
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline auto TaskPromise<void>::get_return_object() noexcept -> Task<void>
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+}  // namespace vsl::tcp
+
+#endif  // VSL_TCP_TCP_TASK_H
@@ -1,16 +1,47 @@
 #include "tcp_client.h"
+#include "tcp_connection_pool.h"
+#include "tcp_framed_connection.h"
 #include "tcp_listener.h"
+#include "tcp_metrics_report.h"
+#include "tcp_sender.h"
+
+#include <vsl/os.h>
+#include <vsl/types.h>
+
+#ifdef VSL_LINUX_OS
+#include "tcp_async.h"
+#include "tcp_server.h"
+#include "tcp_sharded_listener.h"
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -19,13 +50,19 @@ using namespace testing;
 namespace test::tcp
 {
 
+using vsl::tcp::FramedConnection;
 using vsl::tcp::TcpClient;
 using vsl::tcp::TcpClientConnectionReset;
 using vsl::tcp::TcpClientDisconnect;
 using vsl::tcp::TcpClientError;
 using vsl::tcp::TcpClientGracefulShutdown;
+using vsl::tcp::TcpConnectionPool;
 using vsl::tcp::TcpListener;
 using vsl::tcp::TcpListenerError;
+using vsl::tcp::TcpMetrics;
+using vsl::tcp::TcpSender;
+using vsl::tcp::TcpSocketOptions;
+using vsl::tcp::TcpSenderError;
 
 static const auto server_endpoint = std::pair{"0.0.0.0", 8888};
 static const auto client_remote_endpoint = std::pair{"127.0.0.1", 8888};
@@ -88,6 +125,16 @@ class TcpEndiannessTest : public BaseTcpTest
     {}
 };
 
+class TcpBigEndianTest : public BaseTcpTest
+{
+  protected:
+    TcpBigEndianTest()
+        : BaseTcpTest{TcpClient::ByteOrder::BE, TcpClient::ByteOrder::BE}
+    {}
+};
+
+static_assert(!std::is_copy_constructible_v<TcpClient> && std::is_move_constructible_v<TcpClient>);
+
 static auto test_connect(auto start_listener, auto connect_client) -> void
 {
     auto listener = TcpListener{};
@@ -293,6 +340,20 @@ TEST_F(TcpTest, SendRecvBool)
 
     ASSERT_EQ(server_.read<bool>(), true);
     ASSERT_EQ(server_.read<bool>(), false);
+
+    // Any non-zero byte is true
+    for (auto direct_receive : {false, true})
+    {
+        server_.enable_direct_receive(direct_receive);
+
+        const auto raw = std::array<uint8_t, 3>{2, 0xFF, 0};
+        client_.write_raw(raw.data(), raw.size());
+        client_.flush();
+
+        ASSERT_EQ(server_.read<bool>(), true);
+        ASSERT_EQ(server_.read<bool>(TcpClient::Clock::now() + std::chrono::seconds{5}), true);
+        ASSERT_EQ(server_.read<bool>(), false);
+    }
 }
 
 TEST_F(TcpTest, SendRecvFloat)
@@ -398,6 +459,91 @@ TEST_F(TcpTest, DisconnectOnRead)
     ASSERT_THROW(client_.read<int8_t>(), TcpClientDisconnect);
 }
 
+TEST_F(TcpTest, ReadDeadline)
+{
+    using namespace std::chrono_literals;
+
+    for (auto direct_receive : {false, true})
+    {
+        server_.enable_direct_receive(direct_receive);
+
+        auto start = TcpClient::Clock::now();
+        ASSERT_THROW(server_.read<int32_t>(start + 50ms), vsl::tcp::TcpTimeout);
+        ASSERT_GE(TcpClient::Clock::now() - start, 50ms);
+
+        client_.write(int32_t{7});
+        client_.write_string("string");
+        client_.write(int64_t{-1});
+        client_.flush();
+
+        auto deadline = TcpClient::Clock::now() + 5s;
+        ASSERT_EQ(server_.read<int32_t>(deadline), 7);
+        ASSERT_EQ(server_.read_string(deadline), "string");
+        ASSERT_EQ(server_.read<int64_t>(), -1);
+        ASSERT_THROW(server_.read_string(TcpClient::Clock::now()), vsl::tcp::TcpTimeout);
+    }
+
+    server_.enable_direct_receive(false);
+    client_.write(0);
+    client_.flush();
+    ASSERT_THROW(server_.wait_for_disconnect(TcpClient::Clock::now() + 50ms), vsl::tcp::TcpTimeout);
+
+    client_.shutdown(TcpClient::ShutdownType::SEND);
+    server_.wait_for_disconnect(TcpClient::Clock::now() + 5s);
+    ASSERT_THROW(server_.data_available(), TcpClientGracefulShutdown);
+}
+
+TEST_F(TcpTest, FlushDeadline)
+{
+    using namespace std::chrono_literals;
+
+    client_.write(int32_t{7});
+    client_.flush(TcpClient::Clock::now() + 5s);
+    ASSERT_EQ(server_.read<int32_t>(), 7);
+
+    // The server does not read, so the socket buffers fill up
+    client_.set_send_buffer_size(16 * 1024);
+    server_.set_receive_buffer_size(16 * 1024);
+    const auto chunk = std::string(4 * 1024, 'x');
+    auto flush_until_timeout = [&]
+    {
+        while (true)
+        {
+            client_.write_raw(chunk.data(), chunk.size());
+            client_.flush(TcpClient::Clock::now() + 50ms);
+        }
+    };
+
+    auto start = TcpClient::Clock::now();
+    ASSERT_THROW(flush_until_timeout(), vsl::tcp::TcpTimeout);
+    ASSERT_GE(TcpClient::Clock::now() - start, 50ms);
+
+    // The write stream is failed after a timeout
+    ASSERT_THROW(client_.write(int32_t{1}), TcpClientError);
+}
+
+TEST(TcpConnectTest, ConnectTimeout)
+{
+    using namespace std::chrono_literals;
+
+    auto listener = TcpListener{};
+    listener.start(server_endpoint);
+
+    auto client = TcpClient{};
+    client.connect(client_remote_endpoint, 5000ms);
+    ASSERT_TRUE(client.is_active());
+
+    auto server = listener.accept_client();
+    client.write(1);
+    client.flush();
+    ASSERT_EQ(server.read<int>(TcpClient::Clock::now() + 5s), 1);
+
+    client.close();
+    server.close();
+    listener.stop();
+    ASSERT_THROW(TcpClient{}.connect("127.0.0.1", 1, 5000ms), TcpClientError);
+}
+
 TEST_F(TcpTest, DISABLED_ConnectionResetOnFlush)
 {
     // Crashed on linux
@@ -462,6 +608,56 @@ TEST_F(TcpTest, Buffer)
     ASSERT_NO_FATAL_FAILURE(test());  // Repeat after buffer clean
 }
 
+TEST_F(TcpTest, GatherBuffer)
+{
+    const auto large_vec = std::vector<int64_t>(10000, -7);
+    const auto large_str = std::string(1000, 'x');
+
+    client_.set_buffer_mode(TcpClient::BufferMode::GATHER);
+
+    auto test = [&]
+    {
+        client_.write<int32_t>(101);
+
+        client_.enable_buffer(true);
+        client_.write<int32_t>(201);
+        client_.write_vector(large_vec);
+        client_.write_string<TcpClient::size32_t>("Hello");
+        client_.write_string(large_str);
+        client_.write<int16_t>(202);
+        client_.enable_buffer(false);
+
+        constexpr auto EXPECTED_BUFF_SIZE = sizeof(int32_t)                               //
+                                            + sizeof(uint64_t) + 10000 * sizeof(int64_t)  //
+                                            + sizeof(uint32_t) + 5                        //
+                                            + sizeof(uint64_t) + 1000                     //
+                                            + sizeof(int16_t);                            //
+        ASSERT_EQ(client_.buffer_size(), EXPECTED_BUFF_SIZE);
+        EXPECT_THROW(client_.set_buffer_mode(TcpClient::BufferMode::COPY), TcpClientError);
+
+        client_.write<int32_t>(client_.buffer_size());
+        client_.write_buffer();
+        ASSERT_TRUE(client_.buffer_empty());
+
+        client_.write<int32_t>(102);
+        client_.flush();
+
+        ASSERT_EQ(server_.read<int32_t>(), 101);
+        ASSERT_EQ(server_.read<int32_t>(), EXPECTED_BUFF_SIZE);
+        ASSERT_EQ(server_.read<int32_t>(), 201);
+        ASSERT_EQ(server_.read_vector<int64_t>(), large_vec);
+        ASSERT_EQ(server_.read_string<TcpClient::size32_t>(), "Hello");
+        ASSERT_EQ(server_.read_string(), large_str);
+        ASSERT_EQ(server_.read<int16_t>(), 202);
+        ASSERT_EQ(server_.read<int32_t>(), 102);
+    };
+
+    ASSERT_NO_FATAL_FAILURE(test());
+    ASSERT_NO_FATAL_FAILURE(test());  // Repeat after buffer clean
+
+    client_.set_buffer_mode(TcpClient::BufferMode::COPY);
+}
+
 TEST_F(TcpTest, WriteEmptyBuffer)
 {
     client_.write<int32_t>(101);
@@ -483,15 +679,56 @@ TEST_F(TcpTest, WriteEmptyBuffer)
 
 TEST_F(TcpTest, BufferCapacity)
 {
-    constexpr auto INITIAL_BUFFER_RESERVE_SIZE = 1024;
+    constexpr auto BUFFER_RESERVE_SIZE = 2048;
 
-    ASSERT_GE(client_.buffer_capacity(), INITIAL_BUFFER_RESERVE_SIZE);
+    // No chunk is taken until the first buffered write
+    ASSERT_EQ(client_.buffer_capacity(), 0);
 
-    client_.reserve_buffer(INITIAL_BUFFER_RESERVE_SIZE * 2);
-    ASSERT_GE(client_.buffer_capacity(), INITIAL_BUFFER_RESERVE_SIZE * 2);
+    client_.reserve_buffer(BUFFER_RESERVE_SIZE);
+    ASSERT_GE(client_.buffer_capacity(), BUFFER_RESERVE_SIZE);
 
     client_.shrink_buffer_to_fit();
     ASSERT_EQ(client_.buffer_capacity(), 0);
+
+    client_.enable_buffer(true);
+    client_.write<int32_t>(101);
+    client_.enable_buffer(false);
+    ASSERT_GT(client_.buffer_capacity(), 0);
+
+    // Written out buffer goes back to the pool
+    client_.write_buffer();
+    client_.flush();
+    ASSERT_EQ(client_.buffer_capacity(), 0);
+    ASSERT_EQ(server_.read<int32_t>(), 101);
+}
+
+TEST_F(TcpTest, BufferChunks)
+{
+    auto data = std::vector<int32_t>(5000);
+    std::iota(data.begin(), data.end(), 0);
+
+    client_.enable_buffer(true);
+    client_.write_vector(data);
+    client_.write<int32_t>(101);
+    client_.enable_buffer(false);
+    ASSERT_EQ(client_.buffer_size(), sizeof(uint64_t) + data.size() * sizeof(int32_t) + sizeof(int32_t));
+    ASSERT_GE(client_.buffer_capacity(), client_.buffer_size());
+
+    client_.write_buffer();
+    client_.flush();
+    ASSERT_TRUE(client_.buffer_empty());
+    ASSERT_EQ(client_.buffer_capacity(), 0);
+
+    ASSERT_EQ(server_.read_vector<int32_t>(), data);
+    ASSERT_EQ(server_.read<int32_t>(), 101);
+
+    client_.shrink_buffer_to_fit();
+    client_.enable_buffer(true);
+    client_.write<int32_t>(102);
+    client_.enable_buffer(false);
+    client_.write_buffer();
+    client_.flush();
+    ASSERT_EQ(server_.read<int32_t>(), 102);
 }
 
 TEST_F(TcpEndiannessTest, SendRecvDiffEndiannessInt)
@@ -508,4 +745,1583 @@ TEST_F(TcpEndiannessTest, SendRecvDiffEndiannessInt)
     ASSERT_EQ(client_.read<uint16_t>(), value);
 }
 
+TEST_F(TcpEndiannessTest, SendRecvDiffEndiannessItems)
+{
+    auto items = std::array<uint32_t, 2>{0x01020304, 0x05060708};
+    client_.write_items(std::span{items});
+    client_.flush();
+    server_.read_items(std::span{items});
+    ASSERT_THAT(items, ElementsAre(0x04030201, 0x08070605));
+}
+
+TEST_F(TcpBigEndianTest, Vector)
+{
+    auto doubles = std::vector<double>(1001);
+    std::iota(doubles.begin(), doubles.end(), -0.5);
+    auto ints = std::vector<int16_t>{1, -2, 3};
+
+    client_.write_vector(doubles);
+    client_.write_vector<int16_t, TcpClient::size32_t>(ints);
+    client_.write_items(std::span{ints});
+    client_.flush();
+
+    EXPECT_EQ(server_.read_vector<double>(), doubles);
+    EXPECT_EQ((server_.read_vector<int16_t, TcpClient::size32_t>()), ints);
+
+    auto items = std::array<int16_t, 3>{};
+    server_.read_items(std::span{items});
+    EXPECT_THAT(items, ElementsAreArray(ints));
+}
+
+TEST_F(TcpBigEndianTest, VectorIntoSpan)
+{
+    const auto ints = std::vector<int64_t>{1, -2, 3};
+
+    client_.write_vector(ints);
+    client_.write_vector(ints);
+    client_.flush();
+
+    auto storage = std::array<int64_t, 4>{};
+    ASSERT_EQ(server_.read_vector(std::span{storage}), 3);
+    EXPECT_THAT(storage, ElementsAre(1, -2, 3, 0));
+
+    EXPECT_THROW(server_.read_vector(std::span{storage}.first(2)), TcpClientError);
+}
+
+TEST_F(TcpBigEndianTest, VectorGatherAndDirectReceive)
+{
+    auto ints = std::vector<uint64_t>(10000);
+    std::iota(ints.begin(), ints.end(), uint64_t{0x0102030405060708});
+
+    server_.enable_direct_receive(true);
+    client_.set_buffer_mode(TcpClient::BufferMode::GATHER);
+    client_.enable_buffer(true);
+    client_.write_vector(ints);
+    client_.enable_buffer(false);
+    client_.write_buffer();
+
+    EXPECT_EQ(server_.read_vector<uint64_t>(), ints);
+}
+
+TEST(TcpByteOrderTest, ByteswapItems)
+{
+    for (auto size : {0, 1, 7, 8, 9, 33})
+    {
+        auto items = std::vector<uint32_t>(vsl::as_unsigned(size));
+        std::iota(items.begin(), items.end(), uint32_t{0x01020304});
+
+        auto expected = items;
+        for (auto& item : expected)
+        {
+            item = vsl::tcp::detail::byteswap(item);
+        }
+
+        vsl::tcp::detail::byteswap_items(std::span{items});
+        EXPECT_EQ(items, expected);
+    }
+
+    auto value = uint64_t{0x0102030405060708};
+    EXPECT_EQ(vsl::tcp::detail::byteswap(value), 0x0807060504030201);
+    EXPECT_EQ(vsl::tcp::detail::byteswap(uint16_t{0x0102}), 0x0201);
+}
+
+enum class StructKind : uint8_t
+{
+    FIRST = 1,
+    SECOND = 2,
+};
+
+struct StructHeader
+{
+    uint32_t id{};
+    uint16_t type{};
+    StructKind kind{};
+    bool is_last{};
+};
+VSL_TCP_STRUCT(StructHeader, id, type, kind, is_last)
+
+struct StructPoint
+{
+    double x{};
+    double y{};
+
+    auto operator==(const StructPoint&) const -> bool = default;
+};
+VSL_TCP_STRUCT(StructPoint, x, y)
+
+struct StructPadded
+{
+    uint8_t tag{};
+    uint32_t value{};
+};
+VSL_TCP_STRUCT(StructPadded, tag, value)
+
+class StructMessage
+{
+  public:
+    StructHeader header{};
+    std::string name{};
+    std::vector<int32_t> values{};
+    std::vector<StructPoint> points{};
+    std::vector<std::string> tags{};
+    std::array<int16_t, 3> triple{};
+    StructPadded padded{};
+
+    auto secret() const -> int64_t
+    {
+        return secret_;
+    }
+
+    auto set_secret(int64_t secret) -> void
+    {
+        secret_ = secret;
+    }
+
+  private:
+    int64_t secret_{};
+
+    VSL_TCP_STRUCT_INLINE(StructMessage, header, name, values, points, tags, triple, padded, secret_)
+};
+
+struct StructReordered
+{
+    int32_t first{};
+    int32_t second{};
+};
+VSL_TCP_STRUCT(StructReordered, second, first)
+
+static_assert(vsl::tcp::detail::is_flat<StructPoint>());
+static_assert(!vsl::tcp::detail::is_flat<StructHeader>());
+static_assert(!vsl::tcp::detail::is_flat<StructReordered>());
+static_assert(vsl::tcp::detail::is_flat<std::array<StructPoint, 2>>());
+static_assert(!vsl::tcp::detail::is_flat<StructPadded>());
+static_assert(!vsl::tcp::detail::is_flat<StructMessage>());
+
+static auto make_struct_message() -> StructMessage
+{
+    auto message = StructMessage{};
+    message.header = {.id = 0x01020304, .type = 7, .kind = StructKind::SECOND, .is_last = true};
+    message.name = "message";
+    message.values = {1, -2, 3};
+    message.points = {{0.5, -1.5}, {2.5, 3.5}};
+    message.tags = {"a", "", "bc"};
+    message.triple = {-1, 0, 1};
+    message.padded = {.tag = 9, .value = 0x0A0B0C0D};
+    message.set_secret(-42);
+    return message;
+}
+
+static auto expect_struct_message(const StructMessage& message) -> void
+{
+    auto expected = make_struct_message();
+    EXPECT_EQ(message.header.id, expected.header.id);
+    EXPECT_EQ(message.header.type, expected.header.type);
+    EXPECT_EQ(message.header.kind, expected.header.kind);
+    EXPECT_EQ(message.header.is_last, expected.header.is_last);
+    EXPECT_EQ(message.name, expected.name);
+    EXPECT_EQ(message.values, expected.values);
+    EXPECT_EQ(message.points, expected.points);
+    EXPECT_EQ(message.tags, expected.tags);
+    EXPECT_EQ(message.triple, expected.triple);
+    EXPECT_EQ(message.padded.tag, expected.padded.tag);
+    EXPECT_EQ(message.padded.value, expected.padded.value);
+    EXPECT_EQ(message.secret(), expected.secret());
+}
+
+TEST_F(TcpTest, Struct)
+{
+    client_.write_struct(make_struct_message());
+    client_.write_struct(make_struct_message());
+    client_.flush();
+
+    auto message = StructMessage{};
+    server_.read_struct(message);
+    expect_struct_message(message);
+
+    // Storage of the object is reused
+    message.name.reserve(100);
+    auto name_data = message.name.data();
+    auto values_data = message.values.data();
+    server_.read_struct(message);
+    expect_struct_message(message);
+    EXPECT_EQ(message.name.data(), name_data);
+    EXPECT_EQ(message.values.data(), values_data);
+}
+
+TEST_F(TcpTest, StructListedOrder)
+{
+    client_.write_struct(StructReordered{.first = 1, .second = 2});
+    client_.write(uint32_t{0x01020304});
+    client_.write(uint16_t{7});
+    client_.write(uint8_t{2});
+    client_.write(uint8_t{2});
+    client_.flush();
+
+    auto values = std::array<int32_t, 2>{};
+    server_.read_raw(values.data(), values.size());
+    EXPECT_THAT(values, ElementsAre(2, 1));
+
+    // Any nonzero byte is read as true
+    auto header = StructHeader{};
+    server_.read_struct(header);
+    EXPECT_EQ(header.kind, StructKind::SECOND);
+    EXPECT_TRUE(header.is_last);
+}
+
+TEST_F(TcpBigEndianTest, Struct)
+{
+    client_.write_struct(make_struct_message());
+    client_.write(uint32_t{0x01020304});
+    client_.flush();
+
+    auto message = StructMessage{};
+    server_.read_struct(message);
+    expect_struct_message(message);
+
+    auto bytes = std::array<uint8_t, 4>{};
+    server_.read_raw(bytes.data(), bytes.size());
+    EXPECT_THAT(bytes, ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(TcpTest, DirectReceive)
+{
+    server_.enable_direct_receive(true);
+
+    const auto large_str = std::string(1024 * 1024, 'x');
+    const auto ints_sent = std::array<int64_t, 3>{1, -2, 3};
+
+    client_.write(int8_t{-5});
+    client_.write(uint64_t{0x0102030405060708});
+    client_.write(1.5);
+    client_.write_vector(std::vector<int32_t>{7, 8, 9});
+    client_.write_string<TcpClient::size32_t>("Hello");
+    client_.write_string(large_str);
+    client_.write_string("Frame");
+    client_.write_raw(ints_sent.data(), ints_sent.size());
+    client_.flush();
+
+    EXPECT_EQ(server_.read<int8_t>(), -5);
+    EXPECT_EQ(server_.read<uint64_t>(), 0x0102030405060708);
+    EXPECT_EQ(server_.read<double>(), 1.5);
+    EXPECT_THAT(server_.read_vector<int32_t>(), ElementsAre(7, 8, 9));
+    EXPECT_EQ(server_.read_string<TcpClient::size32_t>(), "Hello");
+    EXPECT_EQ(server_.read_string(), large_str);
+
+    auto frame = server_.read_frame();
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(frame.data()), frame.size()), "Frame");
+
+    std::array<int64_t, 3> ints_received;
+    server_.read_raw(ints_received.data(), ints_received.size());
+    EXPECT_THAT(ints_received, ElementsAreArray(ints_sent));
+}
+
+TEST_F(TcpTest, DirectReceiveSwitchMode)
+{
+    client_.write(int16_t{1});
+    client_.write(int16_t{2});
+    client_.write_string("Frame");
+    client_.flush();
+
+    EXPECT_EQ(server_.read<int16_t>(), 1);
+    EXPECT_THROW(server_.enable_direct_receive(true), TcpClientError);
+    EXPECT_EQ(server_.read<int16_t>(), 2);
+
+    auto frame = server_.read_frame();
+    EXPECT_EQ(frame.size(), 5);
+
+    server_.enable_direct_receive(true);
+
+    client_.write(int16_t{3});
+    client_.write(int16_t{4});
+    client_.flush();
+
+    EXPECT_EQ(server_.read<int16_t>(), 3);
+    EXPECT_THROW(server_.enable_direct_receive(false), TcpClientError);
+    EXPECT_EQ(server_.data_available(), 2);
+    EXPECT_EQ(server_.read<int16_t>(), 4);
+    server_.enable_direct_receive(false);
+}
+
+TEST_F(TcpTest, DirectReceiveDisconnect)
+{
+    server_.enable_direct_receive(true);
+
+    client_.write(int32_t{});
+    client_.flush();
+    client_.shutdown();
+
+    server_.read<int8_t>();
+    EXPECT_THROW(server_.read<int32_t>(), TcpClientGracefulShutdown);
+    server_.wait_for_disconnect();
+}
+
+TEST_F(TcpEndiannessTest, DirectReceiveDiffEndianness)
+{
+    server_.enable_direct_receive(true);
+    client_.enable_direct_receive(true);
+
+    const auto value = uint32_t{0x01020304};
+    const auto inverted_value = uint32_t{0x04030201};
+
+    client_.write(value);
+    client_.flush();
+    ASSERT_EQ(server_.read<uint32_t>(), inverted_value);
+
+    server_.write(value);
+    server_.flush();
+    ASSERT_EQ(client_.read<uint32_t>(), inverted_value);
+}
+
+TEST_F(TcpTest, SenderMultipleProducers)
+{
+    constexpr auto PRODUCER_COUNT = 4;
+    constexpr auto FRAME_COUNT = 1000;
+
+    auto sender = TcpSender{client_, 16};
+    EXPECT_EQ(sender.queue_capacity(), 16);
+
+    auto producers = std::vector<std::thread>{};
+    for (auto producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        producers.emplace_back(
+            [&sender, producer]
+            {
+                for (auto i = 0; i < FRAME_COUNT; ++i)
+                {
+                    EXPECT_TRUE(sender.send_vector(std::vector<int32_t>{producer, i}));
+                }
+            });
+    }
+
+    auto next_frames = std::vector<int32_t>(PRODUCER_COUNT, 0);
+    for (auto i = 0; i < PRODUCER_COUNT * FRAME_COUNT; ++i)
+    {
+        auto frame = server_.read_vector<int32_t>();
+        ASSERT_EQ(frame.size(), 2);
+        ASSERT_EQ(frame[1], next_frames.at(vsl::as_unsigned(frame[0]))++);
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    sender.send(int16_t{7});
+    sender.send_string<TcpClient::size32_t>("Hello");
+    sender.stop();
+    EXPECT_FALSE(sender.is_running());
+    EXPECT_THROW(sender.send(0), TcpSenderError);
+
+    EXPECT_EQ(server_.read<int16_t>(), 7);
+    EXPECT_EQ(server_.read_string<TcpClient::size32_t>(), "Hello");
+}
+
+TEST_F(TcpTest, SenderStopRace)
+{
+    constexpr auto PRODUCER_COUNT = 4;
+
+    auto sender = TcpSender{client_, 16};
+    auto sent_count = std::atomic_int{0};
+
+    auto producers = std::vector<std::thread>{};
+    for (auto producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        producers.emplace_back(
+            [&]
+            {
+                try
+                {
+                    while (true)
+                    {
+                        sender.send(int32_t{1});
+                        ++sent_count;
+                    }
+                }
+                catch (const TcpSenderError&)
+                {
+                }
+            });
+    }
+
+    auto received_count = 0;
+    auto reader = std::thread{
+        [&]
+        {
+            while (server_.read<int32_t>() != 0)
+            {
+                ++received_count;
+            }
+        }};
+
+    while (sent_count < 1000)
+    {
+        std::this_thread::yield();
+    }
+
+    // Every frame whose send succeeded is sent before stop() returns
+    sender.stop();
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    client_.write(int32_t{0});
+    client_.flush();
+    reader.join();
+
+    EXPECT_EQ(received_count, sent_count);
+}
+
+static constexpr auto SMALL_SOCKET_BUFFER_SIZE = 16 * 1024;
+
+TEST_F(TcpTest, SenderOverflow)
+{
+    constexpr auto FRAME_COUNT = 10;
+
+    // The writer thread blocks on the first frame until the server reads (exceeds the socket buffers)
+    client_.set_send_buffer_size(SMALL_SOCKET_BUFFER_SIZE);
+    server_.set_receive_buffer_size(SMALL_SOCKET_BUFFER_SIZE);
+    const auto large_str = std::string(1024 * 1024, 'x');
+
+    auto sender = TcpSender{client_, 2, TcpSender::OverflowPolicy::DROP};
+    auto sent_count = 0;
+    for (auto i = 0; i < FRAME_COUNT; ++i)
+    {
+        if (sender.send_string(large_str)) ++sent_count;
+    }
+    EXPECT_GT(sender.get_dropped_count(), 0);
+    EXPECT_EQ(vsl::as_unsigned(sent_count) + sender.get_dropped_count(), FRAME_COUNT);
+
+    auto reader = std::thread{
+        [&]
+        {
+            for (auto i = 0; i < sent_count; ++i)
+            {
+                EXPECT_EQ(server_.read_string(), large_str);
+            }
+        }};
+    sender.stop();
+    reader.join();
+}
+
+TEST_F(TcpTest, SenderOverflowThrow)
+{
+    client_.set_send_buffer_size(SMALL_SOCKET_BUFFER_SIZE);
+    server_.set_receive_buffer_size(SMALL_SOCKET_BUFFER_SIZE);
+    const auto large_str = std::string(1024 * 1024, 'x');
+
+    auto sender = TcpSender{client_, 2, TcpSender::OverflowPolicy::THROW};
+    auto sent_count = 0;
+    try
+    {
+        while (true)
+        {
+            sender.send_string(large_str);
+            ++sent_count;
+        }
+    }
+    catch (const TcpSenderError&)
+    {
+    }
+    EXPECT_GE(sent_count, 2);
+
+    auto reader = std::thread{
+        [&]
+        {
+            for (auto i = 0; i < sent_count; ++i)
+            {
+                EXPECT_EQ(server_.read_string(), large_str);
+            }
+        }};
+    sender.stop();
+    reader.join();
+}
+
+TEST_F(TcpTest, FramedConnectionPipelining)
+{
+    constexpr auto REQUEST_COUNT = 100;
+
+    auto requester = FramedConnection{std::move(client_)};
+    auto responder = FramedConnection{std::move(server_)};
+
+    // Responses are sent in reverse order
+    auto responder_thread = std::thread{
+        [&responder]
+        {
+            // Payloads are valid until the next read, so they are copied
+            auto requests = std::vector<std::tuple<uint64_t, uint16_t, std::string>>{};
+            for (auto i = 0; i < REQUEST_COUNT; ++i)
+            {
+                auto request = responder.read_message();
+                requests.emplace_back(request.request_id, request.type, request.payload);
+            }
+            for (auto& [request_id, type, payload] : requests | std::views::reverse)
+            {
+                responder.send_response(request_id, type, payload + "!");
+            }
+            responder.flush();
+        }};
+
+    auto request_ids = std::vector<uint64_t>{};
+    for (auto i = 0; i < REQUEST_COUNT; ++i)
+    {
+        request_ids.push_back(requester.send_request(vsl::checked_cast<uint16_t>(i), fmt::format("Request {}", i)));
+    }
+    requester.flush();
+    EXPECT_EQ(requester.pending_request_count(), REQUEST_COUNT);
+
+    for (auto i = 0; i < REQUEST_COUNT; ++i)
+    {
+        auto response = requester.wait_response(request_ids[vsl::as_unsigned(i)]);
+        EXPECT_EQ(response.type, i);
+        EXPECT_EQ(response.payload, fmt::format("Request {}!", i));
+    }
+    EXPECT_EQ(requester.pending_request_count(), 0);
+
+    responder_thread.join();
+
+    client_ = std::move(requester.client());
+    server_ = std::move(responder.client());
+}
+
+TEST_F(TcpTest, FramedConnectionCall)
+{
+    auto requester = FramedConnection{std::move(client_)};
+    auto responder = FramedConnection{std::move(server_)};
+    responder.set_max_frame_size(16);
+
+    auto responder_thread = std::thread{
+        [&responder]
+        {
+            auto request = responder.read_message();
+            responder.send_response(request.request_id, 2, "");
+            responder.flush();
+            // The large frame is skipped
+            EXPECT_THROW(responder.read_message(), TcpClientError);
+            EXPECT_EQ(responder.read_message().payload, "Next");
+        }};
+
+    auto response = requester.call(1, "Hello");
+    EXPECT_EQ(response.type, 2);
+    EXPECT_EQ(response.payload, "");
+
+    requester.send_request(3, std::string(1024 * 1024, 'x'));
+    requester.send_request(4, "Next");
+    requester.flush();
+
+    responder_thread.join();
+
+    client_ = std::move(requester.client());
+    server_ = std::move(responder.client());
+}
+
+TEST(TcpConnectionPoolTest, ReuseAndHealthCheck)
+{
+    auto listener = TcpListener{};
+    listener.start(server_endpoint.first, 0);
+    auto endpoint = TcpConnectionPool::Endpoint{client_remote_endpoint.first, listener.get_port()};
+
+    auto pool = TcpConnectionPool{};
+    auto local_endpoint = std::pair<std::string, int>{};
+    {
+        auto lease = pool.acquire(endpoint);
+        local_endpoint = lease->get_local_endpoint();
+    }
+    EXPECT_EQ(pool.idle_count(), 1);
+    EXPECT_EQ(pool.idle_count(endpoint), 1);
+
+    auto server = listener.accept_client();
+    {
+        auto lease = pool.acquire(endpoint);
+        EXPECT_EQ(pool.idle_count(), 0);
+        EXPECT_EQ(lease->get_local_endpoint(), local_endpoint);
+
+        lease->write(int32_t{101});
+        lease->flush();
+        EXPECT_EQ(server.read<int32_t>(), 101);
+    }
+
+    // Closed by the peer while idle
+    server.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        auto lease = pool.acquire(endpoint);
+        EXPECT_NE(lease->get_local_endpoint(), local_endpoint);
+        lease.discard();
+        EXPECT_THROW(lease.client(), TcpClientError);
+    }
+    EXPECT_EQ(pool.idle_count(), 0);
+}
+
+TEST(TcpConnectionPoolTest, IdleLimitsAndEviction)
+{
+    auto listener = TcpListener{};
+    listener.start(server_endpoint.first, 0);
+    auto endpoint = TcpConnectionPool::Endpoint{client_remote_endpoint.first, listener.get_port()};
+
+    auto pool = TcpConnectionPool{};
+    pool.set_max_idle(2);
+    {
+        auto leases = std::vector<TcpConnectionPool::Lease>{};
+        for (auto i = 0; i < 3; ++i)
+        {
+            leases.push_back(pool.acquire(endpoint));
+        }
+    }
+    EXPECT_EQ(pool.idle_count(endpoint), 2);
+
+    // Idle timeout does not go below min idle, missing clients are connected
+    pool.set_min_idle(3);
+    pool.set_max_idle(4);
+    pool.set_idle_timeout(std::chrono::milliseconds(0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pool.evict();
+    EXPECT_EQ(pool.idle_count(endpoint), 3);
+
+    pool.set_min_idle(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pool.evict();
+    EXPECT_EQ(pool.idle_count(endpoint), 1);
+
+    // Reconnects stop at max idle
+    pool.set_min_idle(5);
+    pool.set_max_idle(2);
+    pool.set_connect_timeout(std::chrono::milliseconds(1'000));
+    pool.evict();
+    EXPECT_EQ(pool.idle_count(endpoint), 2);
+
+    // Background eviction
+    pool.set_min_idle(0);
+    pool.set_eviction_interval(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(pool.idle_count(endpoint), 0);
+
+    pool.clear();
+    EXPECT_EQ(pool.idle_count(), 0);
+}
+
+TEST(TcpMetricsTest, LatencyHistogram)
+{
+    auto histogram = vsl::tcp::LatencyHistogram{};
+    EXPECT_EQ(histogram.snapshot().count, 0);
+
+    for (auto us = 1; us <= 1000; ++us)
+    {
+        histogram.record(std::chrono::microseconds{us});
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1000);
+    EXPECT_EQ(snapshot.min_ns, 1'000);
+    EXPECT_EQ(snapshot.mean_ns, 500'500);
+    EXPECT_EQ(snapshot.max_ns, 1'000'000);
+    EXPECT_NEAR(static_cast<double>(snapshot.p50_ns), 500'000.0, 500'000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(snapshot.p90_ns), 900'000.0, 900'000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(snapshot.p99_ns), 990'000.0, 990'000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(snapshot.p999_ns), 999'000.0, 999'000.0 * 0.035);
+
+    histogram.reset();
+    histogram.record(std::chrono::nanoseconds{5});
+    snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1);
+    EXPECT_EQ(snapshot.p50_ns, 5);
+    EXPECT_EQ(snapshot.p999_ns, 5);
+}
+
+TEST_F(TcpTest, Metrics)
+{
+    auto client_metrics = std::make_shared<TcpMetrics>();
+    auto server_metrics = std::make_shared<TcpMetrics>();
+    client_.set_metrics(client_metrics);
+    server_.set_metrics(server_metrics);
+
+    client_.write(int32_t{1});
+    client_.write_string("abc");
+    client_.flush();
+    EXPECT_EQ(client_metrics->bytes_sent, 4 + 8 + 3);
+    EXPECT_EQ(client_metrics->flush_count, 1);
+    EXPECT_EQ(client_metrics->write_latency.snapshot().count, 3);
+
+    // The first read takes the whole flushed data from the socket, the others are served by the stream buffer
+    server_.read<int32_t>();
+    EXPECT_EQ(server_metrics->bytes_received, 4 + 8 + 3);
+    server_.read_string();
+    EXPECT_EQ(server_metrics->bytes_received, 4 + 8 + 3);
+    EXPECT_EQ(server_metrics->read_latency.snapshot().count, 1);
+
+    // Buffered writes are counted when the buffer is written
+    client_.enable_buffer(true);
+    client_.write_string("frame");
+    EXPECT_EQ(client_metrics->bytes_sent, 15);
+    client_.enable_buffer(false);
+    client_.write_buffer();
+    client_.flush();
+    EXPECT_EQ(client_metrics->bytes_sent, 15 + 8 + 5);
+
+    server_.enable_direct_receive(true);
+    server_.read_frame();
+    EXPECT_EQ(server_metrics->bytes_received, 15 + 8 + 5);
+    EXPECT_EQ(server_metrics->frames_received, 1);
+
+    auto snapshot = client_metrics->snapshot();
+    EXPECT_EQ(snapshot.bytes_sent, 28);
+    EXPECT_EQ(snapshot.flush_count, 2);
+    EXPECT_EQ(snapshot.flush_latency.count, 2);
+
+    auto json = vsl::tcp::metrics_to_json(snapshot);
+    EXPECT_EQ(json["bytes_sent"].get<uint64_t>(), 28);
+    EXPECT_EQ(json["flush_latency"]["count"].get<uint64_t>(), 2);
+    EXPECT_EQ(json.get<vsl::tcp::TcpMetricsSnapshot>().write_latency.max_ns, snapshot.write_latency.max_ns);
+    EXPECT_THAT(vsl::tcp::metrics_to_table(snapshot).to_string(), HasSubstr("Bytes sent"));
+
+    client_metrics->reset();
+    EXPECT_EQ(client_metrics->snapshot().bytes_sent, 0);
+    EXPECT_EQ(client_metrics->snapshot().flush_latency.count, 0);
+}
+
+TEST(TcpMetricsTest, ListenerAccepts)
+{
+    auto metrics = std::make_shared<TcpMetrics>();
+
+    auto listener = TcpListener{};
+    listener.set_metrics(metrics);
+    listener.start(server_endpoint);
+
+    auto clients = std::vector<TcpClient>(3);
+    auto servers = std::vector<TcpClient>{};
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint);
+        servers.push_back(listener.accept_client());
+        EXPECT_EQ(servers.back().get_metrics(), metrics);
+    }
+
+    auto snapshot = metrics->snapshot();
+    EXPECT_EQ(snapshot.accept_count, 3);
+    EXPECT_GT(snapshot.accept_rate, 0.0);
+
+    for (auto& client : clients)
+    {
+        client.close();
+    }
+    listener.stop();
+}
+
+TEST_F(TcpTest, FlushPolicy)
+{
+    ASSERT_EQ(client_.get_flush_policy(), TcpClient::FlushPolicy::IMMEDIATE);
+
+    for (auto policy : {TcpClient::FlushPolicy::CORKED,
+                        TcpClient::FlushPolicy::COALESCE,
+                        TcpClient::FlushPolicy::IMMEDIATE})
+    {
+        client_.set_flush_policy(policy);
+        ASSERT_EQ(client_.get_flush_policy(), policy);
+
+        for (auto i = int32_t{0}; i < 100; ++i)
+        {
+            client_.write(i);
+            client_.flush();
+        }
+        client_.write_string("Hello");
+        client_.flush();
+
+        // Coalesced data is sent by the reads
+        server_.write<int32_t>(101);
+        server_.flush();
+        ASSERT_EQ(client_.read<int32_t>(), 101);
+
+        for (auto i = int32_t{0}; i < 100; ++i)
+        {
+            ASSERT_EQ(server_.read<int32_t>(), i);
+        }
+        ASSERT_EQ(server_.read_string(), "Hello");
+    }
+}
+
+TEST_F(TcpTest, NonBlockingWrite)
+{
+    using namespace std::chrono_literals;
+
+    constexpr auto LOW_WATERMARK = size_t{16 * 1024};
+    constexpr auto HIGH_WATERMARK = size_t{256 * 1024};
+
+    client_.set_write_watermarks(LOW_WATERMARK, HIGH_WATERMARK);
+    ASSERT_THROW(client_.set_write_watermarks(HIGH_WATERMARK, LOW_WATERMARK), TcpClientError);
+
+    auto writable_count = 0;
+    client_.on_writable([&] { ++writable_count; });
+
+    // The server does not read, so the socket buffers fill up and the rest is queued
+    auto chunk = std::vector<uint8_t>(64 * 1024);
+    auto sent = std::vector<uint8_t>{};
+    for (auto i = 0; client_.is_writable(); ++i)
+    {
+        ASSERT_LT(i, 100000);
+        std::fill(chunk.begin(), chunk.end(), static_cast<uint8_t>(i));
+        ASSERT_EQ(client_.try_write_raw(chunk.data(), chunk.size()), chunk.size());
+        sent.insert(sent.end(), chunk.begin(), chunk.end());
+    }
+    ASSERT_GT(client_.pending_write_size(), HIGH_WATERMARK);
+    ASSERT_EQ(client_.try_write_raw(chunk.data(), chunk.size()), 0);
+    ASSERT_EQ(writable_count, 0);
+    ASSERT_THROW(client_.wait_writable(TcpClient::Clock::now() + 50ms), vsl::tcp::TcpTimeout);
+
+    auto received = std::vector<uint8_t>(sent.size());
+    auto reader = std::thread{[&] { server_.read_raw(received.data(), received.size()); }};
+
+    while (!client_.send_pending())
+    {
+        client_.wait_writable(TcpClient::Clock::now() + 5s);
+    }
+    reader.join();
+
+    ASSERT_TRUE(client_.is_writable());
+    ASSERT_EQ(client_.pending_write_size(), 0);
+    ASSERT_EQ(writable_count, 1);
+    ASSERT_EQ(received, sent);
+}
+
+TEST(TcpListenerTest, AcceptedNoDelay)
+{
+    for (auto no_delay : {std::optional<bool>{}, std::optional<bool>{false}})
+    {
+        auto listener = TcpListener{};
+        listener.set_client_options(TcpSocketOptions{.no_delay = no_delay});
+        listener.start(server_endpoint.first, 0);
+
+        auto client = TcpClient{};
+        client.connect(server_endpoint.first, listener.get_port());
+        auto server = listener.accept_client();
+
+        EXPECT_EQ(server.get_no_dalay(), no_delay.value_or(true));
+    }
+}
+
+TEST(TcpListenerTest, AcceptClients)
+{
+    constexpr auto CLIENT_COUNT = size_t{3};
+    constexpr auto RECEIVE_BUFFER_SIZE = 256 * 1024;
+
+    auto listener = TcpListener{};
+    listener.set_backlog(16);
+    auto options = TcpSocketOptions::low_latency();
+    options.receive_buffer_size = RECEIVE_BUFFER_SIZE;
+    options.keep_alive = true;
+    listener.set_client_options(options);
+    listener.start(server_endpoint.first, 0);
+    EXPECT_THROW(listener.set_client_options(options), TcpListenerError);
+    EXPECT_THROW(listener.set_backlog(16), TcpListenerError);
+
+    auto clients = std::vector<TcpClient>(CLIENT_COUNT);
+    for (auto& client : clients)
+    {
+        client.connect(server_endpoint.first, listener.get_port());
+    }
+
+    ASSERT_TRUE(listener.accept_clients(0).empty());
+
+    auto servers = listener.accept_clients(CLIENT_COUNT - 1);
+    ASSERT_GE(servers.size(), 1);
+    ASSERT_LE(servers.size(), CLIENT_COUNT - 1);
+    while (servers.size() < CLIENT_COUNT)
+    {
+        auto more = listener.accept_clients(CLIENT_COUNT);
+        std::ranges::move(more, std::back_inserter(servers));
+    }
+    ASSERT_EQ(servers.size(), CLIENT_COUNT);
+
+    listener.stop();
+
+    for (auto i = size_t{0}; i < CLIENT_COUNT; ++i)
+    {
+        clients[i].write(static_cast<int32_t>(i));
+        clients[i].flush();
+    }
+    auto values = std::vector<int32_t>{};
+    for (auto& server : servers)
+    {
+        ASSERT_GE(server.get_receive_buffer_size(), RECEIVE_BUFFER_SIZE);
+        ASSERT_TRUE(server.get_no_dalay());
+        values.push_back(server.read<int32_t>());
+    }
+    std::ranges::sort(values);
+    ASSERT_THAT(values, ElementsAre(0, 1, 2));
+
+    for (auto& client : clients)
+    {
+        client.close();
+    }
+    for (auto& server : servers)
+    {
+        server.close();
+    }
+}
+
+#ifdef VSL_LINUX_OS
+
+using vsl::tcp::AsyncTcpClient;
+using vsl::tcp::AsyncTcpListener;
+using vsl::tcp::Task;
+using vsl::tcp::TcpExecutor;
+using vsl::tcp::TcpServer;
+using vsl::tcp::TcpShardedListener;
+
+TEST(TcpListenerTest, AcceptClientsPartial)
+{
+    constexpr auto CLIENT_COUNT = size_t{3};
+
+    auto listener = TcpListener{};
+    listener.start(server_endpoint.first, 0);
+
+    auto clients = std::vector<TcpClient>(CLIENT_COUNT);
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint.first, listener.get_port());
+    }
+
+    // Room for one more fd: the second accept fails with EMFILE
+    auto saved_limit = rlimit{};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &saved_limit), 0);
+    auto lowest_free_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::close(lowest_free_fd);
+    auto limit = saved_limit;
+    limit.rlim_cur = static_cast<rlim_t>(lowest_free_fd + 1);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limit), 0);
+
+    auto servers = listener.accept_clients(CLIENT_COUNT);
+    EXPECT_EQ(servers.size(), 1);
+    EXPECT_THROW(listener.accept_clients(CLIENT_COUNT), TcpListenerError);
+
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &saved_limit), 0);
+    while (servers.size() < CLIENT_COUNT)
+    {
+        std::ranges::move(listener.accept_clients(CLIENT_COUNT), std::back_inserter(servers));
+    }
+
+    for (auto& client : clients)
+    {
+        client.close();
+    }
+    for (auto& server : servers)
+    {
+        server.close();
+    }
+    listener.stop();
+}
+
+TEST(TcpServerTest, Echo)
+{
+    auto server = TcpServer{};
+    auto connected_count = 0;
+    auto disconnected_count = 0;
+
+    server.on_connect([&](auto&) { ++connected_count; });
+    server.on_frame([](auto& connection, std::string_view frame) { connection.write_string(frame); });
+    server.on_disconnect([&](auto&) { ++disconnected_count; });
+
+    server.start(server_endpoint.first, 0);
+    ASSERT_TRUE(server.is_listening());
+    auto port = server.get_port();
+
+    auto server_thread = std::thread{[&server] { server.run(); }};
+
+    auto clients = std::vector<TcpClient>(3);
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint.first, port);
+    }
+
+    const auto large_str = std::string(1024 * 1024, 'x');
+    for (auto i = 0; auto& client : clients)
+    {
+        client.write_string(fmt::format("Hello {}", i++));
+        client.write_string("");
+        client.write_string(large_str);
+        client.flush();
+    }
+
+    for (auto i = 0; auto& client : clients)
+    {
+        EXPECT_EQ(client.read_string(), fmt::format("Hello {}", i++));
+        EXPECT_EQ(client.read_string(), "");
+        EXPECT_EQ(client.read_string(), large_str);
+    }
+
+    clients[0].close();
+    server.stop();
+    server_thread.join();
+
+    EXPECT_FALSE(server.is_listening());
+    EXPECT_EQ(server.connection_count(), 0);
+    EXPECT_EQ(connected_count, 3);
+    EXPECT_EQ(disconnected_count, 3);
+}
+
+TEST(TcpServerTest, ByteOrderAndClose)
+{
+    auto server = TcpServer{TcpClient::ByteOrder::BE, TcpClient::size32_t{}};
+    server.on_frame(
+        [](auto& connection, std::string_view frame)
+        {
+            connection.write_string(frame);
+            if (frame == "bye") connection.close();
+        });
+
+    server.start(server_endpoint.first, 0);
+    auto server_thread = std::thread{[&server] { server.run(); }};
+
+    auto client = TcpClient{TcpClient::ByteOrder::BE};
+    client.connect(client_remote_endpoint.first, server.get_port());
+
+    client.write_string<TcpClient::size32_t>("Hello");
+    client.write_string<TcpClient::size32_t>("bye");
+    client.write_string<TcpClient::size32_t>("Ignored");
+    client.flush();
+
+    EXPECT_EQ(client.read_string<TcpClient::size32_t>(), "Hello");
+    EXPECT_EQ(client.read_string<TcpClient::size32_t>(), "bye");
+    EXPECT_THROW(client.read<int8_t>(), TcpClientDisconnect);
+
+    server.stop();
+    server_thread.join();
+}
+
+TEST(TcpServerTest, MaxFrameSize)
+{
+    auto server = TcpServer{};
+    server.set_max_frame_size(16);
+    server.on_frame([](auto& connection, std::string_view frame) { connection.write_string(frame); });
+
+    server.start(server_endpoint.first, 0);
+    auto server_thread = std::thread{[&server] { server.run(); }};
+
+    auto client = TcpClient{};
+    client.connect(client_remote_endpoint.first, server.get_port());
+
+    client.write_string(std::string(16, 'a'));
+    client.flush();
+    EXPECT_EQ(client.read_string(), std::string(16, 'a'));
+
+    client.write_string(std::string(17, 'b'));
+    client.flush();
+    EXPECT_THROW(client.read<int8_t>(), TcpClientDisconnect);
+
+    server.stop();
+    server_thread.join();
+}
+
+TEST(TcpServerTest, ErrorsKeepServing)
+{
+    constexpr auto CLIENT_COUNT = 3;
+
+    auto server = TcpServer{};
+    auto connected_count = std::atomic_int{0};
+    auto connection_error_count = std::atomic_int{0};
+    auto accept_error_count = std::atomic_int{0};
+
+    server.on_connect([&](auto&) { ++connected_count; });
+    server.on_frame(
+        [](auto& connection, std::string_view frame)
+        {
+            if (frame == "throw") throw std::runtime_error{"Handler error"};
+            connection.write_string(frame);
+        });
+    server.on_error([&](std::exception_ptr, TcpServer::Connection* connection)
+                    { ++(connection ? connection_error_count : accept_error_count); });
+
+    server.start(server_endpoint.first, 0);
+
+    // Connections are queued by the kernel, accepting them fails with EMFILE until the limit is restored
+    auto clients = std::vector<TcpClient>(CLIENT_COUNT);
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint.first, server.get_port());
+    }
+
+    auto saved_limit = rlimit{};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &saved_limit), 0);
+    auto lowest_free_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::close(lowest_free_fd);
+    auto limit = saved_limit;
+    limit.rlim_cur = static_cast<rlim_t>(lowest_free_fd);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limit), 0);
+
+    auto server_thread = std::thread{[&server] { server.run(); }};
+
+    while (accept_error_count == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ(connected_count, 0);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &saved_limit), 0);
+
+    for (auto i = 0; auto& client : clients)
+    {
+        client.write_string(fmt::format("Hello {}", i++));
+        client.flush();
+    }
+    for (auto i = 0; auto& client : clients)
+    {
+        EXPECT_EQ(client.read_string(), fmt::format("Hello {}", i++));
+    }
+    EXPECT_EQ(connected_count, CLIENT_COUNT);
+
+    // A throwing frame handler disconnects only its client
+    clients[0].write_string("throw");
+    clients[0].flush();
+    EXPECT_THROW(clients[0].read<int8_t>(), TcpClientDisconnect);
+
+    clients[1].write_string("Still served");
+    clients[1].flush();
+    EXPECT_EQ(clients[1].read_string(), "Still served");
+
+    server.stop();
+    server_thread.join();
+    EXPECT_EQ(connection_error_count, 1);
+
+    // Without an error handler the first error is rethrown by run()
+    server.on_error({});
+    server.start(server_endpoint.first, 0);
+    server_thread = std::thread{[&server] { EXPECT_THROW(server.run(), std::runtime_error); }};
+
+    auto client = TcpClient{};
+    client.connect(client_remote_endpoint.first, server.get_port());
+    client.write_string("throw");
+    client.flush();
+    EXPECT_THROW(client.read<int8_t>(), TcpClientDisconnect);
+
+    server.stop();
+    server_thread.join();
+}
+
+TEST(TcpShardedListenerTest, AcceptAndDrain)
+{
+    constexpr auto SHARD_COUNT = 4;
+    constexpr auto CLIENT_COUNT = 32;
+
+    auto listener = TcpShardedListener{SHARD_COUNT};
+    auto accepted_count = std::atomic_int{0};
+    auto accepted_clients = std::vector<TcpClient>{};
+    auto accepted_clients_mutex = std::mutex{};
+
+    listener.start(server_endpoint.first,
+                   0,
+                   [&](TcpClient client, int)
+                   {
+                       ++accepted_count;
+                       auto _ = std::scoped_lock(accepted_clients_mutex);
+                       accepted_clients.push_back(std::move(client));
+                   });
+    ASSERT_TRUE(listener.is_listening());
+    EXPECT_EQ(listener.shard_count(), SHARD_COUNT);
+
+    auto clients = std::vector<TcpClient>(CLIENT_COUNT);
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint.first, listener.get_port());
+    }
+
+    // Connections queued by the kernel are accepted before the sockets are closed
+    listener.stop();
+    EXPECT_FALSE(listener.is_listening());
+    EXPECT_EQ(accepted_count, CLIENT_COUNT);
+    EXPECT_EQ(accepted_clients.size(), CLIENT_COUNT);
+
+    auto counts = listener.get_accept_counts();
+    EXPECT_EQ(counts.size(), SHARD_COUNT);
+    EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), uint64_t{0}), CLIENT_COUNT);
+    EXPECT_EQ(listener.get_accept_count(0), counts[0]);
+
+    for (auto& client : accepted_clients)
+    {
+        client.write<int32_t>(101);
+        client.flush();
+    }
+    for (auto& client : clients)
+    {
+        EXPECT_EQ(client.read<int32_t>(), 101);
+    }
+}
+
+TEST(TcpShardedListenerTest, ErrorsAndPinning)
+{
+    constexpr auto CLIENT_COUNT = 4;
+
+    auto listener = TcpShardedListener{2};
+    listener.set_shard_cpus({0});
+
+    auto accepted_count = std::atomic_int{0};
+    auto is_pinned = std::atomic_bool{true};
+    auto accepted_clients = std::vector<TcpClient>{};
+    auto accepted_clients_mutex = std::mutex{};
+
+    auto handler = [&](TcpClient client, int)
+    {
+        if (sched_getcpu() != 0) is_pinned = false;
+        if (accepted_count++ % 2 == 0) throw std::runtime_error{"Handler error"};
+
+        auto _ = std::scoped_lock(accepted_clients_mutex);
+        accepted_clients.push_back(std::move(client));
+    };
+
+    // Without an error handler the first error is rethrown by stop(), the shards keep accepting
+    listener.start(fmt::format("{}:0", client_remote_endpoint.first), handler);
+    EXPECT_THROW(listener.set_shard_cpus({}), vsl::tcp::TcpListenerError);
+
+    auto clients = std::vector<TcpClient>(CLIENT_COUNT);
+    for (auto& client : clients)
+    {
+        client.connect(client_remote_endpoint.first, listener.get_port());
+    }
+
+    EXPECT_THROW(listener.stop(), std::runtime_error);
+    EXPECT_EQ(accepted_count, CLIENT_COUNT);
+    EXPECT_EQ(accepted_clients.size(), CLIENT_COUNT / 2);
+    EXPECT_TRUE(is_pinned);
+
+    auto error_count = std::atomic_int{0};
+    listener.on_error([&](std::exception_ptr, int) { ++error_count; });
+    listener.start(client_remote_endpoint.first, 0, handler);
+
+    for (auto& client : clients)
+    {
+        client.close();
+        client.connect(client_remote_endpoint.first, listener.get_port());
+    }
+
+    listener.stop();
+    EXPECT_EQ(accepted_count, CLIENT_COUNT * 2);
+    EXPECT_EQ(error_count, CLIENT_COUNT / 2);
+}
+
+static auto async_echo_session(AsyncTcpListener& listener, int session_count) -> Task<>
+{
+    for (auto i = 0; i < session_count; ++i)
+    {
+        auto client = co_await listener.async_accept_client(TcpClient::ByteOrder::BE);
+        try
+        {
+            while (true)
+            {
+                auto str = co_await client.async_read_string<TcpClient::size32_t>();
+                co_await client.async_write_string<TcpClient::size32_t>(str);
+            }
+        }
+        catch (const TcpClientDisconnect&)
+        {
+        }
+    }
+}
+
+static auto async_client_session(TcpExecutor& executor, int port, std::vector<std::string>& results) -> Task<>
+{
+    auto client = AsyncTcpClient{executor, TcpClient::ByteOrder::BE};
+    co_await client.async_connect(client_remote_endpoint.first, port);
+
+    const auto vec = std::vector<int64_t>{1, -2, 3};
+    co_await client.async_write<uint16_t>(0x0102);
+    co_await client.async_write_vector(vec);
+    co_await client.async_write_string<TcpClient::size32_t>("Hello");
+    co_await client.async_write_string<TcpClient::size32_t>(std::string(1024 * 1024, 'x'));
+
+    results.push_back(fmt::format("{:x}", co_await client.async_read<uint16_t>()));
+    results.push_back(fmt::format("{}", co_await client.async_read_vector<int64_t>()));
+    results.push_back(co_await client.async_read_string<TcpClient::size32_t>());
+    results.push_back(co_await client.async_read_string<TcpClient::size32_t>());
+}
+
+static auto async_raw_echo(AsyncTcpListener& listener) -> Task<>
+{
+    auto client = co_await listener.async_accept_client(TcpClient::ByteOrder::BE);
+    auto value = co_await client.async_read<uint16_t>();
+    auto vec = co_await client.async_read_vector<int64_t>();
+    co_await client.async_write(value);
+    co_await client.async_write_vector(vec);
+    for (auto i = 0; i < 2; ++i)
+    {
+        auto str = co_await client.async_read_string<TcpClient::size32_t>();
+        co_await client.async_write_string<TcpClient::size32_t>(str);
+    }
+}
+
+TEST(TcpAsyncTest, Echo)
+{
+    auto executor = TcpExecutor{};
+    auto listener = AsyncTcpListener{executor};
+    listener.start(server_endpoint.first, 0);
+    ASSERT_TRUE(listener.is_listening());
+
+    auto results = std::vector<std::string>{};
+    executor.spawn(async_raw_echo(listener));
+    executor.spawn(async_client_session(executor, listener.get_port(), results));
+    EXPECT_EQ(executor.task_count(), 2);
+
+    executor.run();
+
+    EXPECT_EQ(executor.task_count(), 0);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(results[0], "102");
+    EXPECT_EQ(results[1], "[1, -2, 3]");
+    EXPECT_EQ(results[2], "Hello");
+    EXPECT_EQ(results[3], std::string(1024 * 1024, 'x'));
+}
+
+TEST(TcpAsyncTest, SyncClientInterop)
+{
+    constexpr auto CLIENT_COUNT = 3;
+
+    auto executor = TcpExecutor{};
+    auto listener = AsyncTcpListener{executor};
+    listener.start(server_endpoint.first, 0);
+    auto port = listener.get_port();
+
+    executor.spawn(async_echo_session(listener, CLIENT_COUNT));
+
+    auto client_thread = std::thread{
+        [port]
+        {
+            for (auto i = 0; i < CLIENT_COUNT; ++i)
+            {
+                auto client = TcpClient{TcpClient::ByteOrder::BE};
+                client.connect(client_remote_endpoint.first, port);
+                client.write_string<TcpClient::size32_t>(fmt::format("Hello {}", i));
+                client.write_string<TcpClient::size32_t>("");
+                client.flush();
+                EXPECT_EQ(client.read_string<TcpClient::size32_t>(), fmt::format("Hello {}", i));
+                EXPECT_EQ(client.read_string<TcpClient::size32_t>(), "");
+            }
+        }};
+
+    executor.run();
+    client_thread.join();
+
+    EXPECT_EQ(executor.task_count(), 0);
+}
+
+static auto async_read_bools(AsyncTcpListener& listener, std::vector<bool>& results) -> Task<>
+{
+    auto client = co_await listener.async_accept_client();
+    for (auto i = 0; i < 3; ++i)
+    {
+        results.push_back(co_await client.async_read<bool>());
+    }
+}
+
+TEST(TcpAsyncTest, ReadBool)
+{
+    auto executor = TcpExecutor{};
+    auto listener = AsyncTcpListener{executor};
+    listener.start(server_endpoint.first, 0);
+    auto port = listener.get_port();
+
+    auto results = std::vector<bool>{};
+    executor.spawn(async_read_bools(listener, results));
+
+    auto client_thread = std::thread{
+        [port]
+        {
+            auto client = TcpClient{};
+            client.connect(client_remote_endpoint.first, port);
+            const auto raw = std::array<uint8_t, 3>{2, 0xFF, 0};
+            client.write_raw(raw.data(), raw.size());
+            client.flush();
+        }};
+
+    executor.run();
+    client_thread.join();
+
+    EXPECT_EQ(results, (std::vector<bool>{true, true, false}));
+}
+
+static auto async_connect_refused(TcpExecutor& executor, int port, bool& is_refused) -> Task<>
+{
+    auto client = AsyncTcpClient{executor};
+    try
+    {
+        co_await client.async_connect(client_remote_endpoint.first, port);
+    }
+    catch (const TcpClientError&)
+    {
+        is_refused = true;
+    }
+}
+
+TEST(TcpAsyncTest, ConnectRefused)
+{
+    auto listener = TcpListener{};
+    listener.start(server_endpoint.first, 0);
+    auto port = listener.get_port();
+    listener.stop();
+
+    auto executor = TcpExecutor{};
+    auto is_refused = false;
+    executor.spawn(async_connect_refused(executor, port, is_refused));
+    executor.run();
+
+    EXPECT_TRUE(is_refused);
+}
+
+static auto async_throw() -> Task<>
+{
+    throw TcpClientError{"Test"};
+    co_return;
+}
+
+TEST(TcpAsyncTest, TaskException)
+{
+    auto executor = TcpExecutor{};
+    executor.spawn(async_throw());
+    EXPECT_THROW(executor.run(), TcpClientError);
+}
+
+TEST_F(TcpTest, FlushPolicyCoalesce)
+{
+    using namespace std::chrono_literals;
+
+    client_.set_flush_policy(TcpClient::FlushPolicy::COALESCE);
+    client_.set_coalesce_threshold(64, 1h);
+
+    // After a pause, sent at once
+    client_.write<int32_t>(101);
+    client_.flush();
+    EXPECT_FALSE(client_.poll_flush());
+    ASSERT_EQ(server_.read<int32_t>(TcpClient::Clock::now() + 1s), 101);
+
+    // Within the delay, held until the size threshold
+    client_.write<int32_t>(102);
+    client_.flush();
+    EXPECT_TRUE(client_.poll_flush());
+
+    auto values = std::vector<int32_t>(16, 103);
+    client_.write_vector(values);
+    client_.flush();
+    EXPECT_FALSE(client_.poll_flush());
+    ASSERT_EQ(server_.read<int32_t>(TcpClient::Clock::now() + 1s), 102);
+    ASSERT_EQ(server_.read_vector<int32_t>(), values);
+
+    // Held data is sent before the reads
+    client_.write<int32_t>(104);
+    client_.flush();
+    server_.write<int32_t>(201);
+    server_.flush();
+    ASSERT_EQ(client_.read<int32_t>(), 201);
+    EXPECT_FALSE(client_.poll_flush());
+    ASSERT_EQ(server_.read<int32_t>(TcpClient::Clock::now() + 1s), 104);
+
+    // Held data is sent by poll_flush() after the delay
+    client_.write<int32_t>(105);
+    client_.flush();
+    client_.set_coalesce_threshold(64, 10ms);
+    auto push_time = client_.poll_flush();
+    ASSERT_TRUE(push_time);
+    std::this_thread::sleep_until(*push_time);
+    EXPECT_FALSE(client_.poll_flush());
+    ASSERT_EQ(server_.read<int32_t>(TcpClient::Clock::now() + 1s), 105);
+}
+
+TEST(TcpUnixTest, ListenerClient)
+{
+    const auto socket_path = (std::filesystem::temp_directory_path() / "vsl_tcp_test.sock").string();
+    std::filesystem::remove(socket_path);
+
+    auto listener = TcpListener{TcpClient::Transport::UNIX};
+    ASSERT_THROW(listener.start(8888), TcpListenerError);
+    listener.start(socket_path);
+    ASSERT_TRUE(listener.is_listening());
+    ASSERT_EQ(listener.get_local_endpoint(), std::pair(socket_path, 0));
+
+    auto client = TcpClient{TcpClient::ByteOrder::BE, TcpClient::Transport::UNIX};
+    ASSERT_THROW(client.connect("127.0.0.1", 8888), TcpClientError);
+    client.connect(socket_path);
+    auto server = listener.accept_client(TcpClient::ByteOrder::BE);
+    ASSERT_EQ(server.get_transport(), TcpClient::Transport::UNIX);
+
+    listener.stop();
+    ASSERT_FALSE(std::filesystem::exists(socket_path));
+
+    client.set_flush_policy(TcpClient::FlushPolicy::COALESCE);
+    client.write<int32_t>(101);
+    client.write_string("Hello");
+    client.write_vector(std::vector<double>{1.5, -2.5});
+    client.flush();
+
+    ASSERT_EQ(server.read<int32_t>(), 101);
+    ASSERT_EQ(server.read_string(), "Hello");
+    ASSERT_THAT(server.read_vector<double>(), ElementsAre(1.5, -2.5));
+
+    client.close();
+    ASSERT_THROW(server.read<int32_t>(), TcpClientGracefulShutdown);
+    server.close();
+}
+
+static_assert(!std::is_copy_constructible_v<TcpListener> && std::is_move_constructible_v<TcpListener>
+              && std::is_move_assignable_v<TcpListener>);
+
+TEST(TcpUnixTest, ListenerDestructor)
+{
+    const auto socket_path = (std::filesystem::temp_directory_path() / "vsl_tcp_test.sock").string();
+    std::filesystem::remove(socket_path);
+
+    {
+        auto listener = TcpListener{TcpClient::Transport::UNIX};
+        listener.start(socket_path);
+        ASSERT_TRUE(std::filesystem::exists(socket_path));
+    }
+    ASSERT_FALSE(std::filesystem::exists(socket_path));
+}
+
+TEST(TcpUnixTest, ListenerMove)
+{
+    const auto socket_path = (std::filesystem::temp_directory_path() / "vsl_tcp_test.sock").string();
+    const auto other_socket_path = (std::filesystem::temp_directory_path() / "vsl_tcp_test_other.sock").string();
+    std::filesystem::remove(socket_path);
+    std::filesystem::remove(other_socket_path);
+
+    auto make_listener = [](const std::string& path)
+    {
+        auto listener = TcpListener{TcpClient::Transport::UNIX};
+        listener.start(path);
+        return listener;
+    };
+
+    {
+        auto listeners = std::vector<TcpListener>{};
+        listeners.push_back(make_listener(socket_path));
+        ASSERT_TRUE(std::filesystem::exists(socket_path));
+
+        auto client = TcpClient{TcpClient::ByteOrder::NATIVE, TcpClient::Transport::UNIX};
+        client.connect(socket_path);
+        auto server = listeners[0].accept_client();
+        client.write<int32_t>(7);
+        client.flush();
+        ASSERT_EQ(server.read<int32_t>(), 7);
+
+        listeners[0] = make_listener(other_socket_path);
+        ASSERT_FALSE(std::filesystem::exists(socket_path));
+        ASSERT_TRUE(std::filesystem::exists(other_socket_path));
+    }
+    ASSERT_FALSE(std::filesystem::exists(other_socket_path));
+}
+
+TEST(TcpUnixTest, SocketPair)
+{
+    auto [first, second] = TcpClient::make_pair(TcpClient::ByteOrder::LE);
+    ASSERT_TRUE(first.is_active());
+    ASSERT_EQ(first.get_transport(), TcpClient::Transport::UNIX);
+
+    first.write<uint16_t>(0x0102);
+    first.flush();
+    ASSERT_EQ(second.read<uint16_t>(), 0x0102);
+
+    second.enable_direct_receive(true);
+    first.write_string("Hello");
+    first.flush();
+    ASSERT_EQ(second.read_string(), "Hello");
+
+    first.close();
+    second.close();
+}
+
+#endif
+
 }  // namespace test::tcp
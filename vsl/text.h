@@ -2,8 +2,10 @@
 #define VSL_TEXT_H
 
 #include <vsl/concepts.h>
+#include <vsl/encoding.h>
 #include <vsl/enum.h>
 #include <vsl/types.h>
+#include <vsl/unicode.h>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
@@ -60,55 +62,124 @@ VSL_DECLARE_ENUM_FLAGS(SplitOptions)
 inline constexpr auto LF = std::string_view{"\n"};
 inline constexpr auto CRLF = std::string_view{"\r\n"};
 
+namespace detail
+{
+
+inline constexpr auto ascii_to_upper(char c) noexcept -> char
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+}
+
+inline constexpr auto ascii_to_lower(char c) noexcept -> char
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+template<typename Func>
+inline auto append_transformed(std::string& out, std::string_view str, Func func) -> void
+{
+    const auto start = out.size();
+    out.resize(start + str.size());
+    std::ranges::transform(str, out.data() + start, func);
+}
+
+}  // namespace detail
+
+inline auto to_upper(std::string& out, std::string_view str, AsciiTag) -> void
+{
+    detail::append_transformed(out, str, detail::ascii_to_upper);
+}
+
+[[nodiscard]]
+inline auto to_upper(std::string_view str, AsciiTag) -> std::string
+{
+    auto res = std::string{};
+    to_upper(res, str, ascii);
+    return res;
+}
+
+inline auto to_lower(std::string& out, std::string_view str, AsciiTag) -> void
+{
+    detail::append_transformed(out, str, detail::ascii_to_lower);
+}
+
+[[nodiscard]]
+inline auto to_lower(std::string_view str, AsciiTag) -> std::string
+{
+    auto res = std::string{};
+    to_lower(res, str, ascii);
+    return res;
+}
+
+// NOTE: Pure ASCII input is mapped with the ASCII kernels; it gives the same result without allocations.
+//       Only that path writes into 'out' directly: uni-algo has no output iterator API for case mapping,
+//       so other input allocates a temporary string which is then appended.
+template<typename = void>
+inline auto to_upper(std::string& out, std::string_view str) -> void
+{
+    if (vsl::is_ascii(str))
+    {
+        to_upper(out, str, ascii);
+        return;
+    }
+    out.append(una::cases::to_uppercase_utf8<char>(str));
+}
+
 template<typename = void>
 [[nodiscard]]
 inline auto to_upper(std::string_view str) -> std::string
 {
+    if (vsl::is_ascii(str)) return to_upper(str, ascii);
     return una::cases::to_uppercase_utf8<char>(str);
 }
 
-[[nodiscard]]
-inline auto to_upper(std::string_view str, AsciiTag) -> std::string
+template<typename = void>
+inline auto to_lower(std::string& out, std::string_view str) -> void
 {
-    auto res = std::string{str};
-    for (char& c : res)
+    if (vsl::is_ascii(str))
     {
-        if (c >= 'a' && c <= 'z')
-        {
-            c -= ('a' - 'A');
-        }
+        to_lower(out, str, ascii);
+        return;
     }
-    return res;
+    out.append(una::cases::to_lowercase_utf8<char>(str));
 }
 
 template<typename = void>
 [[nodiscard]]
 inline auto to_lower(std::string_view str) -> std::string
 {
+    if (vsl::is_ascii(str)) return to_lower(str, ascii);
     return una::cases::to_lowercase_utf8<char>(str);
 }
 
-[[nodiscard]]
-inline auto to_lower(std::string_view str, AsciiTag) -> std::string
+// Full case folding of ASCII is lowercasing
+template<typename = void>
+inline auto to_casefold(std::string& out, std::string_view str) -> void
 {
-    auto res = std::string{str};
-    for (char& c : res)
+    if (vsl::is_ascii(str))
     {
-        if (c >= 'A' && c <= 'Z')
-        {
-            c += ('a' - 'A');
-        }
+        to_lower(out, str, ascii);
+        return;
     }
-    return res;
+    out.append(una::cases::to_casefold_utf8<char>(str));
 }
 
 template<typename = void>
 [[nodiscard]]
 inline auto to_casefold(std::string_view str) -> std::string
 {
+    if (vsl::is_ascii(str)) return to_lower(str, ascii);
     return una::cases::to_casefold_utf8<char>(str);
 }
 
+// NOTE: No ASCII fast path: word boundaries follow Unicode word break rules even for ASCII.
+//       Always allocates a temporary string, see to_upper()
+template<typename = void>
+inline auto to_titlecase(std::string& out, std::string_view str) -> void
+{
+    out.append(una::cases::to_titlecase_utf8<char>(str));
+}
+
 template<typename = void>
 [[nodiscard]]
 inline auto to_titlecase(std::string_view str) -> std::string
@@ -197,6 +268,102 @@ inline auto collate_str(std::string_view str1, std::string_view str2, IgnoreCase
     return una::caseless::collate_utf8<char>(str1, str2);
 }
 
+// Binary sort key: comparing keys as byte strings (memcmp, std::string::compare)
+// gives the same order as compare_str(). Ill-formed sequences are replaced with U+FFFD.
+[[nodiscard]]
+inline auto make_sort_key(std::string_view str) -> std::string
+{
+    if (vsl::is_valid_utf8(str)) return std::string{str};
+
+    auto res = std::string{};
+    res.reserve(str.size() + 2);
+
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+    while (it != end)
+    {
+        const auto cp = detail::decode_utf8(it, end);
+        detail::append_utf8(res, (cp == detail::INVALID_CODEPOINT) ? detail::REPLACEMENT_CHAR : cp);
+    }
+
+    return res;
+}
+
+// Same as above for compare_str(..., ignore_case): the key is the case folded string
+template<typename = void>
+[[nodiscard]]
+inline auto make_sort_key(std::string_view str, IgnoreCaseTag) -> std::string
+{
+    return una::cases::to_casefold_utf8<char>(str);
+}
+
+namespace detail
+{
+
+template<typename R, typename Proj>
+concept sort_str_range = std::ranges::random_access_range<R>
+                         && std::indirectly_movable_storable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>>
+                         && std::invocable<Proj&, std::ranges::range_reference_t<R>>
+                         && std::convertible_to<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>,
+                                                std::string_view>;
+
+template<typename R, typename Proj, typename MakeKey>
+inline auto sort_str_impl(R&& range, Proj& proj, MakeKey make_key) -> void
+{
+    const auto size = static_cast<size_t>(std::ranges::distance(range));
+    if (size < 2) return;
+
+    struct KeyIndex
+    {
+        std::string key;
+        size_t index;
+    };
+
+    auto keys = std::vector<KeyIndex>{};
+    keys.reserve(size);
+    for (auto it = std::ranges::begin(range); it != std::ranges::end(range); ++it)
+    {
+        const auto str = std::string_view{std::invoke(proj, *it)};
+        keys.push_back({make_key(str), keys.size()});
+    }
+
+    std::ranges::stable_sort(keys, std::less{}, &KeyIndex::key);
+
+    using ValueType = std::ranges::range_value_t<R>;
+    auto sorted = std::vector<ValueType>{};
+    sorted.reserve(size);
+    const auto first = std::ranges::begin(range);
+    for (const auto& key : keys)
+    {
+        sorted.push_back(std::ranges::iter_move(first + static_cast<std::ranges::range_difference_t<R>>(key.index)));
+    }
+    std::ranges::move(sorted, first);
+}
+
+}  // namespace detail
+
+// Stable sort in compare_str() order with sort keys computed once per element
+template<typename R, typename Proj = std::identity>
+    requires detail::sort_str_range<R, Proj>
+inline auto sort_str(R&& range, Proj proj = {}) -> void
+{
+    detail::sort_str_impl(range, proj, [](std::string_view str) { return make_sort_key(str); });
+}
+
+template<typename R, typename Proj = std::identity>
+    requires detail::sort_str_range<R, Proj>
+inline auto sort_str(R&& range, Proj proj, IgnoreCaseTag) -> void
+{
+    detail::sort_str_impl(range, proj, [](std::string_view str) { return make_sort_key(str, ignore_case); });
+}
+
+template<typename R>
+    requires detail::sort_str_range<R, std::identity>
+inline auto sort_str(R&& range, IgnoreCaseTag) -> void
+{
+    sort_str(range, std::identity{}, ignore_case);
+}
+
 template<typename = void>
 [[nodiscard]]
 inline auto find_substr(std::string_view str1, std::string_view str2) -> FoundSubstr
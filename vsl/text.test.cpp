@@ -43,6 +43,34 @@ TEST(TextTest, CaseAscii)
     EXPECT_EQ(vsl::to_lower("ЮНИкод", vsl::ascii), "ЮНИкод");
 }
 
+TEST(TextTest, CaseToOutput)
+{
+    auto out = std::string{"> "};
+    vsl::to_upper(out, "abc Straße");
+    EXPECT_EQ(out, "> ABC STRASSE");
+
+    out = "> ";
+    vsl::to_lower(out, "ABC ДВА");
+    EXPECT_EQ(out, "> abc два");
+
+    out = "> ";
+    vsl::to_casefold(out, "ABC");
+    EXPECT_EQ(out, "> abc");
+
+    out = "> ";
+    vsl::to_titlecase(out, "teMPuS eDAX");
+    EXPECT_EQ(out, "> Tempus Edax");
+
+    out = "> ";
+    vsl::to_upper(out, "az", vsl::ascii);
+    vsl::to_lower(out, " AZ", vsl::ascii);
+    EXPECT_EQ(out, "> AZ az");
+
+    EXPECT_EQ(vsl::to_upper("az AZ 09"), "AZ AZ 09");
+    EXPECT_EQ(vsl::to_lower("az AZ 09"), "az az 09");
+    EXPECT_EQ(vsl::to_casefold("az AZ 09"), "az az 09");
+}
+
 TEST(TextTest, IsEqual)
 {
     EXPECT_TRUE(vsl::is_equal("юникод", "юникод"));
@@ -194,6 +222,54 @@ TEST(TextTest, CompareStr)
     // TODO: Add vsl::compare_str tests
 }
 
+TEST(TextTest, SortKey)
+{
+    const auto strs = std::vector<std::string>{"", "a", "B", "b", "ab", "Straße", "STRASSE", "арбуз", "Арбуз", "te\xC2st"};
+
+    auto sign = [](int value) { return (value > 0) - (value < 0); };
+
+    for (const auto& str1 : strs)
+    {
+        for (const auto& str2 : strs)
+        {
+            const auto key1 = vsl::make_sort_key(str1);
+            const auto key2 = vsl::make_sort_key(str2);
+            EXPECT_EQ(sign(key1.compare(key2)), sign(vsl::compare_str(str1, str2))) << str1 << " " << str2;
+
+            const auto ci_key1 = vsl::make_sort_key(str1, vsl::ignore_case);
+            const auto ci_key2 = vsl::make_sort_key(str2, vsl::ignore_case);
+            EXPECT_EQ(sign(ci_key1.compare(ci_key2)), sign(vsl::compare_str(str1, str2, vsl::ignore_case)))
+                << str1 << " " << str2;
+        }
+    }
+
+    EXPECT_EQ(vsl::make_sort_key("te\xC2st"), "te\uFFFDst");
+    EXPECT_EQ(vsl::make_sort_key("Straße", vsl::ignore_case), vsl::make_sort_key("STRASSE", vsl::ignore_case));
+}
+
+TEST(TextTest, SortStr)
+{
+    auto vec = std::vector<std::string>{"браво", "астра", "АЛЬФА", "ОМЕГА", "альфа"};
+    vsl::sort_str(vec);
+    EXPECT_THAT(vec, ElementsAre("АЛЬФА", "ОМЕГА", "альфа", "астра", "браво"));
+    vsl::sort_str(vec, vsl::ignore_case);
+    EXPECT_THAT(vec, ElementsAre("АЛЬФА", "альфа", "астра", "браво", "ОМЕГА"));
+
+    struct Person
+    {
+        std::string name;
+        int id;
+    };
+
+    auto persons = std::vector<Person>{{"Борис", 1}, {"анна", 2}, {"Анна", 3}};
+    vsl::sort_str(persons, &Person::name, vsl::ignore_case);
+    EXPECT_THAT(persons, ElementsAre(Field(&Person::id, 2), Field(&Person::id, 3), Field(&Person::id, 1)));
+
+    auto empty = std::vector<std::string>{};
+    vsl::sort_str(empty);
+    EXPECT_TRUE(empty.empty());
+}
+
 TEST(TextTest, CollateStr)
 {
     EXPECT_EQ(vsl::collate_str("арбуз", "арбуз"), 0);
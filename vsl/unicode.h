@@ -4,14 +4,244 @@
 #include <uni_algo/conv.h>
 #include <uni_algo/norm.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define VSL_DETAIL_UNICODE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace vsl
 {
 
+namespace detail
+{
+
+inline constexpr auto INVALID_CODEPOINT = char32_t{0xFFFF'FFFF};
+inline constexpr auto REPLACEMENT_CHAR = char32_t{0xFFFD};
+
+// Decodes one code point and advances 'it'. On an ill-formed sequence returns INVALID_CODEPOINT
+// and skips its maximal subpart (the same U+FFFD substitution practice uni-algo follows)
+inline constexpr auto decode_utf8(const char*& it, const char* end) noexcept -> char32_t
+{
+    const auto lead = static_cast<unsigned char>(*it++);
+    if (lead < 0x80) return lead;
+
+    auto tail_count = 0;
+    auto cp = char32_t{};
+    auto lower = 0x80;
+    auto upper = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        tail_count = 1;
+        cp = lead & 0x1Fu;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        tail_count = 2;
+        cp = lead & 0x0Fu;
+        if (lead == 0xE0) lower = 0xA0;
+        if (lead == 0xED) upper = 0x9F;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        tail_count = 3;
+        cp = lead & 0x07u;
+        if (lead == 0xF0) lower = 0x90;
+        if (lead == 0xF4) upper = 0x8F;
+    }
+    else
+    {
+        return INVALID_CODEPOINT;
+    }
+
+    for (auto i = 0; i < tail_count; ++i)
+    {
+        if (it == end) return INVALID_CODEPOINT;
+
+        const auto tail = static_cast<unsigned char>(*it);
+        if (tail < lower || tail > upper) return INVALID_CODEPOINT;
+
+        cp = (cp << 6) | (tail & 0x3Fu);
+        lower = 0x80;
+        upper = 0xBF;
+        ++it;
+    }
+
+    return cp;
+}
+
+// Length of the leading pure ASCII part of the string
+inline auto ascii_prefix_size(const char* data, size_t size) noexcept -> size_t
+{
+    auto pos = size_t{0};
+
+#if defined(VSL_DETAIL_UNICODE_SSE2)
+    constexpr auto BLOCK_SIZE = size_t{16};
+    for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const auto high_bits = _mm_movemask_epi8(block);
+        if (high_bits != 0) break;
+    }
+#else
+    constexpr auto BLOCK_SIZE = size_t{8};
+    constexpr auto HIGH_BITS_MASK = uint64_t{0x8080'8080'8080'8080};
+    for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE)
+    {
+        auto block = uint64_t{};
+        std::memcpy(&block, data + pos, BLOCK_SIZE);
+        if ((block & HIGH_BITS_MASK) != 0) break;
+    }
+#endif
+
+    while (pos < size && static_cast<unsigned char>(data[pos]) < 0x80)
+    {
+        ++pos;
+    }
+    return pos;
+}
+
+inline constexpr auto is_high_surrogate(char32_t c) noexcept -> bool
+{
+    return c >= 0xD800 && c <= 0xDBFF;
+}
+
+inline constexpr auto is_low_surrogate(char32_t c) noexcept -> bool
+{
+    return c >= 0xDC00 && c <= 0xDFFF;
+}
+
+// Decodes one code point and advances 'it'. Unpaired surrogates are replaced with U+FFFD.
+inline constexpr auto decode_utf16(const char16_t*& it, const char16_t* end) noexcept -> char32_t
+{
+    const auto unit = static_cast<char32_t>(*it++);
+    if (!is_high_surrogate(unit) && !is_low_surrogate(unit)) return unit;
+
+    if (is_high_surrogate(unit) && it != end && is_low_surrogate(*it))
+    {
+        const auto low = static_cast<char32_t>(*it++);
+        return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    return REPLACEMENT_CHAR;
+}
+
+inline constexpr auto utf8_size(char32_t cp) noexcept -> size_t
+{
+    if (cp < 0x80) return 1;
+    if (cp < 0x800) return 2;
+    if (cp < 0x10000) return 3;
+    return 4;
+}
+
+inline constexpr auto utf16_size(char32_t cp) noexcept -> size_t
+{
+    return (cp < 0x10000) ? 1 : 2;
+}
+
+inline auto append_utf8(std::string& out, char32_t cp) -> void
+{
+    if (cp < 0x80)
+    {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+        const char buf[] = {static_cast<char>(0xC0 | (cp >> 6)),  //
+                            static_cast<char>(0x80 | (cp & 0x3F))};
+        out.append(buf, sizeof(buf));
+    }
+    else if (cp < 0x10000)
+    {
+        const char buf[] = {static_cast<char>(0xE0 | (cp >> 12)),         //
+                            static_cast<char>(0x80 | ((cp >> 6) & 0x3F)),  //
+                            static_cast<char>(0x80 | (cp & 0x3F))};
+        out.append(buf, sizeof(buf));
+    }
+    else
+    {
+        const char buf[] = {static_cast<char>(0xF0 | (cp >> 18)),          //
+                            static_cast<char>(0x80 | ((cp >> 12) & 0x3F)),  //
+                            static_cast<char>(0x80 | ((cp >> 6) & 0x3F)),   //
+                            static_cast<char>(0x80 | (cp & 0x3F))};
+        out.append(buf, sizeof(buf));
+    }
+}
+
+inline auto append_utf16(std::u16string& out, char32_t cp) -> void
+{
+    if (cp < 0x10000)
+    {
+        out += static_cast<char16_t>(cp);
+    }
+    else
+    {
+        cp -= 0x10000;
+        out += static_cast<char16_t>(0xD800 + (cp >> 10));
+        out += static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+    }
+}
+
+struct CodepointRange
+{
+    char32_t first;
+    char32_t last;
+};
+
+// Quick check tables: conservative subsets of code points that have Quick_Check=Yes and ccc=0
+// for the normalization form, i.e. can neither change nor interact with neighbours.
+// Anything outside of them is passed to uni-algo together with its surrounding segment.
+inline constexpr CodepointRange NFC_STABLE_RANGES[] = {
+    {0x0000, 0x02FF},  // Latin, IPA, spacing modifier letters
+    {0x0400, 0x0482},  // Cyrillic
+    {0x048A, 0x04FF},  //
+    {0x4E00, 0x9FFF},  // CJK Unified Ideographs
+};
+
+inline constexpr CodepointRange NFD_STABLE_RANGES[] = {
+    {0x0000, 0x00BF},  // ASCII, Latin-1 symbols
+    {0x0410, 0x0418},  // Russian alphabet except Й, й, Ё, ё
+    {0x041A, 0x0438},  //
+    {0x043A, 0x044F},  //
+    {0x4E00, 0x9FFF},  // CJK Unified Ideographs
+};
+
+inline constexpr CodepointRange NFKC_STABLE_RANGES[] = {
+    {0x0000, 0x009F},  // ASCII, C1 controls
+    {0x00C0, 0x00FF},  // Latin-1 letters
+    {0x0400, 0x0482},  // Cyrillic
+    {0x048A, 0x04FF},  //
+    {0x4E00, 0x9FFF},  // CJK Unified Ideographs
+};
+
+inline constexpr CodepointRange NFKD_STABLE_RANGES[] = {
+    {0x0000, 0x009F},  // ASCII, C1 controls
+    {0x0410, 0x0418},  // Russian alphabet except Й, й, Ё, ё
+    {0x041A, 0x0438},  //
+    {0x043A, 0x044F},  //
+    {0x4E00, 0x9FFF},  // CJK Unified Ideographs
+};
+
+template<size_t N>
+inline constexpr auto is_in_ranges(char32_t cp, const CodepointRange (&ranges)[N]) noexcept -> bool
+{
+    for (const auto& range : ranges)
+    {
+        if (cp < range.first) return false;
+        if (cp <= range.last) return true;
+    }
+    return false;
+}
+
+}  // namespace detail
+
 using una::is_valid_utf16;
-using una::is_valid_utf8;
 
 using una::norm::to_nfc_utf8;
 using una::norm::to_nfd_utf8;
@@ -23,20 +253,242 @@ using una::norm::is_nfd_utf8;
 using una::norm::is_nfkc_utf8;
 using una::norm::is_nfkd_utf8;
 
-template<typename = void>
+enum class NormalizationForm
+{
+    NFC,
+    NFD,
+    NFKC,
+    NFKD,
+};
+
+namespace detail
+{
+
+inline auto is_norm_stable(char32_t cp, NormalizationForm form) noexcept -> bool
+{
+    switch (form)
+    {
+    case NormalizationForm::NFC:
+        return is_in_ranges(cp, NFC_STABLE_RANGES);
+    case NormalizationForm::NFD:
+        return is_in_ranges(cp, NFD_STABLE_RANGES);
+    case NormalizationForm::NFKC:
+        return is_in_ranges(cp, NFKC_STABLE_RANGES);
+    case NormalizationForm::NFKD:
+        return is_in_ranges(cp, NFKD_STABLE_RANGES);
+    }
+    return false;
+}
+
+inline auto normalize(std::string_view str, NormalizationForm form) -> std::string
+{
+    switch (form)
+    {
+    case NormalizationForm::NFC:
+        return una::norm::to_nfc_utf8<char>(str);
+    case NormalizationForm::NFD:
+        return una::norm::to_nfd_utf8<char>(str);
+    case NormalizationForm::NFKC:
+        return una::norm::to_nfkc_utf8<char>(str);
+    case NormalizationForm::NFKD:
+        return una::norm::to_nfkd_utf8<char>(str);
+    }
+    return std::string{str};
+}
+
+}  // namespace detail
+
+// Normalizes the string in place, rewriting only the segments that fail the quick check.
+// Already normalized input costs a read-only scan. Returns true if the string was changed.
+inline auto normalize_if_needed(std::string& str, NormalizationForm form) -> bool
+{
+    auto changed = false;
+    auto pos = size_t{0};
+    auto segment_start = size_t{0};
+
+    while (pos < str.size())
+    {
+        const auto ascii_size = detail::ascii_prefix_size(str.data() + pos, str.size() - pos);
+        if (ascii_size > 0)
+        {
+            pos += ascii_size;
+            segment_start = pos - 1;
+            continue;
+        }
+
+        const auto* it = str.data() + pos;
+        const auto* const end = str.data() + str.size();
+
+        const auto cp = detail::decode_utf8(it, end);
+        if (cp != detail::INVALID_CODEPOINT && detail::is_norm_stable(cp, form))
+        {
+            segment_start = pos;
+            pos = static_cast<size_t>(it - str.data());
+            continue;
+        }
+
+        // Segment: the last stable code point (it may combine with what follows) up to the next stable one
+        auto segment_end = str.size();
+        while (it != end)
+        {
+            const auto* const cp_start = it;
+            const auto next_cp = detail::decode_utf8(it, end);
+            if (next_cp != detail::INVALID_CODEPOINT && detail::is_norm_stable(next_cp, form))
+            {
+                segment_end = static_cast<size_t>(cp_start - str.data());
+                break;
+            }
+        }
+
+        const auto segment = std::string_view{str}.substr(segment_start, segment_end - segment_start);
+        const auto normalized = detail::normalize(segment, form);
+        if (normalized != segment)
+        {
+            str.replace(segment_start, segment.size(), normalized);
+            changed = true;
+        }
+
+        pos = segment_start + normalized.size();
+        segment_start = pos;
+    }
+
+    return changed;
+}
+
+// Only runs of ASCII are vectorized (SSE2, or 8-byte words on other targets),
+// multibyte sequences are checked one code point at a time
 [[nodiscard]]
-inline auto utf16to8(std::u16string_view str) -> std::string
+inline auto is_valid_utf8(std::string_view str) noexcept -> bool
+{
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    while (it != end)
+    {
+        it += detail::ascii_prefix_size(it, static_cast<size_t>(end - it));
+        if (it == end) break;
+
+        if (detail::decode_utf8(it, end) == detail::INVALID_CODEPOINT) return false;
+    }
+
+    return true;
+}
+
+// char8_t input and error position reporting are left to uni-algo
+[[nodiscard]]
+inline auto is_valid_utf8(std::u8string_view str) -> bool
 {
-    return una::utf16to8<char16_t, char>(str);
+    return una::is_valid_utf8(str);
+}
+
+[[nodiscard]]
+inline auto is_valid_utf8(std::string_view str, una::error& error) -> bool
+{
+    return una::is_valid_utf8(str, error);
+}
+
+[[nodiscard]]
+inline auto is_valid_utf8(std::u8string_view str, una::error& error) -> bool
+{
+    return una::is_valid_utf8(str, error);
+}
+
+// Exact size of the utf8to16() result
+[[nodiscard]]
+inline auto utf8to16_size(std::string_view str) noexcept -> size_t
+{
+    auto res = size_t{0};
+
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    while (it != end)
+    {
+        const auto ascii_size = detail::ascii_prefix_size(it, static_cast<size_t>(end - it));
+        res += ascii_size;
+        it += ascii_size;
+        if (it == end) break;
+
+        const auto cp = detail::decode_utf8(it, end);
+        res += (cp == detail::INVALID_CODEPOINT) ? 1 : detail::utf16_size(cp);
+    }
+
+    return res;
+}
+
+// Exact size of the utf16to8() result
+[[nodiscard]]
+inline auto utf16to8_size(std::u16string_view str) noexcept -> size_t
+{
+    auto res = size_t{0};
+
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    while (it != end)
+    {
+        res += detail::utf8_size(detail::decode_utf16(it, end));
+    }
+
+    return res;
+}
+
+// Ill-formed sequences are replaced with U+FFFD
+inline auto utf8to16(std::u16string& out, std::string_view str) -> void
+{
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    while (it != end)
+    {
+        const auto* const ascii_end = it + detail::ascii_prefix_size(it, static_cast<size_t>(end - it));
+        out.append(it, ascii_end);
+        it = ascii_end;
+        if (it == end) break;
+
+        const auto cp = detail::decode_utf8(it, end);
+        detail::append_utf16(out, (cp == detail::INVALID_CODEPOINT) ? detail::REPLACEMENT_CHAR : cp);
+    }
 }
 
-template<typename = void>
 [[nodiscard]]
 inline auto utf8to16(std::string_view str) -> std::u16string
 {
-    return una::utf8to16<char, char16_t>(str);
+    auto res = std::u16string{};
+    res.reserve(utf8to16_size(str));
+    utf8to16(res, str);
+    return res;
+}
+
+// Unpaired surrogates are replaced with U+FFFD
+inline auto utf16to8(std::string& out, std::u16string_view str) -> void
+{
+    const auto* it = str.data();
+    const auto* const end = str.data() + str.size();
+
+    while (it != end)
+    {
+        if (*it < 0x80)
+        {
+            out += static_cast<char>(*it++);
+            continue;
+        }
+
+        detail::append_utf8(out, detail::decode_utf16(it, end));
+    }
+}
+
+[[nodiscard]]
+inline auto utf16to8(std::u16string_view str) -> std::string
+{
+    auto res = std::string{};
+    res.reserve(utf16to8_size(str));
+    utf16to8(res, str);
+    return res;
 }
 
 }  // namespace vsl
 
+#undef VSL_DETAIL_UNICODE_SSE2
+
 #endif  // VSL_UNICODE_H
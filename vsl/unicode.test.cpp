@@ -42,6 +42,45 @@ TEST(UnicodeTest, IsValidUtf8)
     EXPECT_TRUE(vsl::is_valid_utf8("тест"));
     EXPECT_TRUE(vsl::is_valid_utf8(std::string{"тест"}));
     EXPECT_TRUE(vsl::is_valid_utf8(std::string_view{"тест"}));
+    EXPECT_TRUE(vsl::is_valid_utf8(u8"тест"));
+    EXPECT_TRUE(vsl::is_valid_utf8(std::u8string{u8"тест"}));
+    EXPECT_TRUE(vsl::is_valid_utf8(std::u8string_view{u8"тест"}));
+
+    // Error reporting
+    auto error = una::error{};
+    EXPECT_TRUE(vsl::is_valid_utf8("тест", error));
+    EXPECT_FALSE(error);
+    EXPECT_TRUE(vsl::is_valid_utf8(u8"тест", error));
+    EXPECT_FALSE(error);
+}
+
+TEST(UnicodeTest, IsValidUtf8IllFormed)
+{
+    EXPECT_TRUE(vsl::is_valid_utf8("\x7F"));
+    EXPECT_TRUE(vsl::is_valid_utf8("\xF0\x9F\x9A\xA7"));  // U+1F6A7
+    EXPECT_TRUE(vsl::is_valid_utf8("\xF4\x8F\xBF\xBF"));  // U+10FFFF
+
+    EXPECT_FALSE(vsl::is_valid_utf8("\x80"));              // Lone continuation byte
+    EXPECT_FALSE(vsl::is_valid_utf8("\xC0\xAF"));          // Overlong
+    EXPECT_FALSE(vsl::is_valid_utf8("\xE0\x80\xAF"));      // Overlong
+    EXPECT_FALSE(vsl::is_valid_utf8("\xED\xA0\x80"));      // Surrogate
+    EXPECT_FALSE(vsl::is_valid_utf8("\xF4\x90\x80\x80"));  // Above U+10FFFF
+    EXPECT_FALSE(vsl::is_valid_utf8("\xF5\x80\x80\x80"));
+    EXPECT_FALSE(vsl::is_valid_utf8("\xD1"));              // Truncated
+    EXPECT_FALSE(vsl::is_valid_utf8("\xE2\x80"));
+
+    // Ill-formed sequence before, inside and after ASCII blocks
+    const auto ascii = std::string(40, 'a');
+    for (auto pos = size_t{0}; pos <= ascii.size(); ++pos)
+    {
+        auto str = ascii;
+        str.insert(pos, "\xD1\x82");
+        EXPECT_TRUE(vsl::is_valid_utf8(str)) << pos;
+
+        str = ascii;
+        str.insert(pos, "\xD1");
+        EXPECT_FALSE(vsl::is_valid_utf8(str)) << pos;
+    }
 }
 
 TEST(UnicodeTest, Normalization)
@@ -77,6 +116,42 @@ TEST(UnicodeTest, Normalization)
     EXPECT_TRUE(vsl::is_nfc_utf8(std::string_view{"Ŵ"}));
 }
 
+TEST(UnicodeTest, NormalizeIfNeeded)
+{
+    using enum vsl::NormalizationForm;
+
+    auto normalize = [](std::string str, vsl::NormalizationForm form, bool expect_changed)
+    {
+        EXPECT_EQ(vsl::normalize_if_needed(str, form), expect_changed);
+        return str;
+    };
+
+    EXPECT_EQ(normalize("", NFC, false), "");
+    EXPECT_EQ(normalize("test", NFC, false), "test");
+    EXPECT_EQ(normalize("тест Ŵ", NFC, false), "тест Ŵ");
+    EXPECT_EQ(normalize("Ŵ W\u0302", NFC, true), "Ŵ Ŵ");
+    EXPECT_EQ(normalize("W\u0302 тест W\u0302", NFC, true), "Ŵ тест Ŵ");
+
+    EXPECT_EQ(normalize("тест", NFD, false), "тест");
+    EXPECT_EQ(normalize("Ŵ W\u0302", NFD, true), "W\u0302 W\u0302");
+    EXPECT_EQ(normalize("Ёлка", NFD, true), "Е\u0308лка");
+
+    EXPECT_EQ(normalize("тест", NFKC, false), "тест");
+    EXPECT_EQ(normalize("ﬃ 2\u2075 Ŵ W\u0302", NFKC, true), "ffi 25 Ŵ Ŵ");
+
+    EXPECT_EQ(normalize("тест", NFKD, false), "тест");
+    EXPECT_EQ(normalize("ﬃ 2\u2075 Ŵ W\u0302", NFKD, true), "ffi 25 W\u0302 W\u0302");
+
+    // Same result as full normalization
+    for (const auto* str : {"Ŵ W\u0302 ﬃ", "Ёж й", "a\u0301\u0323b", "te\xC2st", "가\u11A8", "\u0344 \u0F73"})
+    {
+        EXPECT_EQ(normalize(str, NFC, vsl::to_nfc_utf8(str) != str), vsl::to_nfc_utf8(str));
+        EXPECT_EQ(normalize(str, NFD, vsl::to_nfd_utf8(str) != str), vsl::to_nfd_utf8(str));
+        EXPECT_EQ(normalize(str, NFKC, vsl::to_nfkc_utf8(str) != str), vsl::to_nfkc_utf8(str));
+        EXPECT_EQ(normalize(str, NFKD, vsl::to_nfkd_utf8(str) != str), vsl::to_nfkd_utf8(str));
+    }
+}
+
 TEST(UnicodeTest, Utf16To8)
 {
     EXPECT_EQ(vsl::utf16to8(u""), "");
@@ -85,6 +160,8 @@ TEST(UnicodeTest, Utf16To8)
     EXPECT_EQ(vsl::utf16to8(u"\x74\x65\x73\x74"), "test");
     EXPECT_EQ(vsl::utf16to8(u"\x442\x435\x441\x442"), "тест");
     EXPECT_EQ(vsl::utf16to8(u"te\xD800st"), "te�st");
+    EXPECT_EQ(vsl::utf16to8(u"\xDEA7\xD83D"), "��");
+    EXPECT_EQ(vsl::utf16to8(u"\xD83D\xDEA7"), "🚧");
 }
 
 TEST(UnicodeTest, Utf8To16)
@@ -95,6 +172,33 @@ TEST(UnicodeTest, Utf8To16)
     EXPECT_EQ(vsl::utf8to16("test"), u"\x74\x65\x73\x74");
     EXPECT_EQ(vsl::utf8to16("тест"), u"\x442\x435\x441\x442");
     EXPECT_EQ(vsl::utf8to16("te\xC2st"), u"te�st");
+    EXPECT_EQ(vsl::utf8to16("\xF0\x9F\x9A\xA7"), u"\xD83D\xDEA7");
+    EXPECT_EQ(vsl::utf8to16("\xED\xA0\x80!"), u"���!");
+    EXPECT_EQ(vsl::utf8to16(std::string(20, 'a') + "тест"), std::u16string(20, u'a') + u"тест");
+}
+
+TEST(UnicodeTest, ConvertToOutput)
+{
+    auto str16 = std::u16string{u"> "};
+    vsl::utf8to16(str16, "тест 🚧");
+    EXPECT_EQ(str16, u"> тест 🚧");
+
+    auto str8 = std::string{"> "};
+    vsl::utf16to8(str8, u"тест 🚧");
+    EXPECT_EQ(str8, "> тест 🚧");
+}
+
+TEST(UnicodeTest, ConvertedSize)
+{
+    for (const auto* str : {"", "test", "тест", "te\xC2st", "🚧 \xF0\x9F", "\xED\xA0\x80!"})
+    {
+        EXPECT_EQ(vsl::utf8to16_size(str), vsl::utf8to16(str).size()) << str;
+    }
+
+    for (const auto* str : {u"", u"test", u"тест", u"te\xD800st", u"🚧 \xDEA7"})
+    {
+        EXPECT_EQ(vsl::utf16to8_size(str), vsl::utf16to8(str).size());
+    }
 }
 
 }  // namespace test